@@ -0,0 +1,169 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Group of a CompactMesh */
+template <typename Index>
+struct CompactGroup {
+  /**
+   * @param name name of the group
+   * @param type type of the group
+   * @param ids members of the group, vertices or elements indices depending
+   * on the group type
+   */
+  std::string name;
+  GroupType type;
+  std::vector<Index> ids;
+};
+
+/* UNV mesh stored with configurable index and coordinate types */
+template <typename Index, typename Real>
+struct CompactMesh {
+  /**
+   * @brief Mesh with `Index` ids and `Real` coordinates, and elements
+   * connectivity stored in compressed rows: the vertices of element i are
+   * elements_vertices_ids[elements_offsets[i], elements_offsets[i + 1]).
+   *
+   * With 32-bit ids and float coordinates, connectivity and coordinates take
+   * half the memory of Mesh, which also avoids one allocation per element.
+   *
+   * @param vertices vertices coordinates
+   * @param elements_types type of each element
+   * @param elements_offsets start of each element vertices, plus the total
+   * connectivity size
+   * @param elements_vertices_ids vertices ids of all elements
+   * @param groups groups of the mesh
+   * @param unit_system units system of the mesh
+   */
+  std::vector<std::array<Real, 3>> vertices;
+  std::vector<ElementType> elements_types;
+  std::vector<Index> elements_offsets;
+  std::vector<Index> elements_vertices_ids;
+  std::vector<CompactGroup<Index>> groups;
+  std::optional<UnitsSystem> unit_system;
+
+  auto elements_count() const noexcept -> std::size_t {
+    return elements_types.size();
+  }
+};
+
+/**
+ * @brief Convert a mesh to compact storage.
+ *
+ * @param mesh mesh to convert
+ * @return CompactMesh<Index, Real>
+ * @throw std::runtime_error If an id, a count or a coordinate does not fit in
+ * `Index` or `Real`.
+ */
+template <typename Index, typename Real>
+auto to_compact(const Mesh &mesh) -> CompactMesh<Index, Real>;
+
+/**
+ * @brief Read UNV mesh from file into compact storage.
+ *
+ * The file is parsed at full width, then each dataset is narrowed and its
+ * full width copy released before the next one is narrowed. Double
+ * coordinates are moved as parsed, without a copy.
+ *
+ * @param path path to the UNV file
+ * @return CompactMesh<Index, Real>
+ * @throw std::runtime_error If the file cannot be read, or if an id, a count
+ * or a coordinate does not fit in `Index` or `Real`.
+ */
+template <typename Index = std::uint32_t, typename Real = float>
+auto read_compact(const std::filesystem::path &path)
+    -> CompactMesh<Index, Real>;
+
+/**
+ * @brief Read UNV mesh from file into compact storage, with options.
+ *
+ * The executor, dataset handlers, validation and vertices transforms of the
+ * options apply as in read(), their placement does not. With double
+ * coordinates the parsed vertices array is moved into the compact mesh
+ * rather than copied.
+ *
+ * @param path path to the UNV file
+ * @param options read options
+ * @return CompactMesh<Index, Real>
+ * @throw std::runtime_error If the file cannot be read, if a record is
+ * invalid under Validation::Strict, or if an id, a count or a coordinate does
+ * not fit in `Index` or `Real`.
+ */
+template <typename Index = std::uint32_t, typename Real = float>
+auto read_compact(const std::filesystem::path &path, const ReadOptions &options)
+    -> CompactMesh<Index, Real>;
+
+// supported index and coordinate types, instantiated in the library
+extern template auto to_compact<std::uint32_t, float>(const Mesh &)
+    -> CompactMesh<std::uint32_t, float>;
+extern template auto to_compact<std::uint32_t, double>(const Mesh &)
+    -> CompactMesh<std::uint32_t, double>;
+extern template auto to_compact<std::uint64_t, float>(const Mesh &)
+    -> CompactMesh<std::uint64_t, float>;
+extern template auto to_compact<std::uint64_t, double>(const Mesh &)
+    -> CompactMesh<std::uint64_t, double>;
+
+extern template auto
+read_compact<std::uint32_t, float>(const std::filesystem::path &)
+    -> CompactMesh<std::uint32_t, float>;
+extern template auto
+read_compact<std::uint32_t, double>(const std::filesystem::path &)
+    -> CompactMesh<std::uint32_t, double>;
+extern template auto
+read_compact<std::uint64_t, float>(const std::filesystem::path &)
+    -> CompactMesh<std::uint64_t, float>;
+extern template auto
+read_compact<std::uint64_t, double>(const std::filesystem::path &)
+    -> CompactMesh<std::uint64_t, double>;
+
+extern template auto
+read_compact<std::uint32_t, float>(const std::filesystem::path &,
+                                   const ReadOptions &)
+    -> CompactMesh<std::uint32_t, float>;
+extern template auto
+read_compact<std::uint32_t, double>(const std::filesystem::path &,
+                                    const ReadOptions &)
+    -> CompactMesh<std::uint32_t, double>;
+extern template auto
+read_compact<std::uint64_t, float>(const std::filesystem::path &,
+                                   const ReadOptions &)
+    -> CompactMesh<std::uint64_t, float>;
+extern template auto
+read_compact<std::uint64_t, double>(const std::filesystem::path &,
+                                    const ReadOptions &)
+    -> CompactMesh<std::uint64_t, double>;
+
+} // namespace unvpp
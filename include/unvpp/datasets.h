@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace unvpp {
+
+/*
+ * Callable invoked with the number of a dataset and its record lines, the
+ * lines between the dataset number line and the closing separator line.
+ */
+using DatasetHandler = std::function<void(
+    std::size_t dataset, const std::vector<std::string_view> &lines)>;
+
+/* Handlers of the UNV datasets not read by unvpp */
+class DatasetRegistry {
+  /**
+   * @brief Datasets unvpp does not read (2420, 18, ...) are skipped without
+   * copying their lines, unless a handler is registered for their number.
+   * The lines of a handled dataset are read in a single buffer, and passed
+   * to the handler as views into it, which are only valid during the call.
+   *
+   * Handlers are called in file order, from the thread calling read(), and
+   * exceptions they throw are propagated to the caller.
+   */
+public:
+  void add(std::size_t dataset, DatasetHandler handler);
+  void remove(std::size_t dataset);
+  auto find(std::size_t dataset) const noexcept -> const DatasetHandler *;
+  auto empty() const noexcept -> bool;
+
+private:
+  std::unordered_map<std::size_t, DatasetHandler> _handlers;
+};
+
+} // namespace unvpp
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace unvpp {
+
+/* Runs the parallel loops of unvpp */
+class Executor {
+  /**
+   * @brief Interface to plug a host application thread pool into unvpp.
+   *
+   * unvpp splits its loops into chunks whose boundaries depend only on the
+   * data, and combines per chunk results in chunk order, so results are
+   * bitwise identical whatever executor runs the chunks.
+   */
+public:
+  Executor() = default;
+  Executor(const Executor &other) = delete;
+  Executor(Executor &&other) = delete;
+  auto operator=(const Executor &other) -> Executor & = delete;
+  auto operator=(Executor &&other) -> Executor & = delete;
+  virtual ~Executor() = default;
+
+  /**
+   * @brief Run task(i) for each i in [0, n_tasks), possibly concurrently,
+   * and return once all tasks are done. Tasks do not throw, and may call
+   * parallel_for() again from inside a task.
+   */
+  virtual void parallel_for(std::size_t n_tasks,
+                            const std::function<void(std::size_t)> &task) = 0;
+
+  /**
+   * @brief Number of tasks running at the same time, used to size batches
+   * of work.
+   */
+  virtual auto concurrency() const noexcept -> std::size_t = 0;
+};
+
+/* Executor running all tasks in order on the calling thread */
+class SequentialExecutor final : public Executor {
+public:
+  void parallel_for(std::size_t n_tasks,
+                    const std::function<void(std::size_t)> &task) override;
+  auto concurrency() const noexcept -> std::size_t override;
+};
+
+/* Executor running tasks on a pool of persistent threads */
+class ThreadPool final : public Executor {
+  /**
+   * @brief The calling thread and the pool threads take tasks from a shared
+   * counter until none is left, so idle threads pick up the remaining work
+   * of slower ones, and nested loops progress even when all pool threads
+   * are busy.
+   *
+   * @param n_threads number of threads running tasks, including the calling
+   * thread, zero for the number of hardware threads
+   */
+public:
+  explicit ThreadPool(std::size_t n_threads = 0);
+  ~ThreadPool() override;
+
+  void parallel_for(std::size_t n_tasks,
+                    const std::function<void(std::size_t)> &task) override;
+  auto concurrency() const noexcept -> std::size_t override;
+
+private:
+  struct State;
+  std::unique_ptr<State> _state;
+};
+
+/**
+ * @brief Process wide thread pool used when no executor is set.
+ */
+auto default_executor() -> Executor &;
+
+/**
+ * @brief Executor of the innermost ExecutorScope of the calling thread, or
+ * the default executor.
+ */
+auto current_executor() -> Executor &;
+
+/* Sets the executor used by unvpp on the calling thread while alive */
+class ExecutorScope {
+  /**
+   * @brief Parallel loops started in the scope, including from mesh
+   * processing functions such as compute_geometry() or renumber(), run on
+   * `executor`, which must outlive the scope. Scopes can be nested.
+   */
+public:
+  explicit ExecutorScope(Executor &executor) noexcept;
+  ExecutorScope(const ExecutorScope &other) = delete;
+  ExecutorScope(ExecutorScope &&other) = delete;
+  auto operator=(const ExecutorScope &other) -> ExecutorScope & = delete;
+  auto operator=(ExecutorScope &&other) -> ExecutorScope & = delete;
+  ~ExecutorScope();
+
+private:
+  Executor *_previous;
+};
+
+} // namespace unvpp
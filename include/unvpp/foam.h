@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Encoding of the OpenFOAM lists */
+enum class FoamFormat : std::uint8_t {
+  Ascii,
+  Binary,
+};
+
+/* Options of write_foam() */
+struct FoamOptions {
+  /**
+   * @param format ascii, or binary lists in host byte order
+   * @param default_patch name of the patch of the boundary faces which are
+   * not part of any group
+   */
+  FoamFormat format{FoamFormat::Ascii};
+  std::string default_patch{"defaultFaces"};
+};
+
+/**
+ * @brief Write a mesh as an OpenFOAM polyMesh directory: points, faces,
+ * owner, neighbour, boundary and cellZones.
+ *
+ * Volume elements are the cells, numbered in the order of Mesh::elements().
+ * Their faces are extracted and sorted by vertices in parallel, internal
+ * faces are ordered by owner then neighbour. Boundary faces are grouped in
+ * one patch per element group of triangles and quads, in the groups order,
+ * the remaining ones going to `options.default_patch`, and element groups of
+ * cells are written as cell zones. Groups names are turned into valid
+ * OpenFOAM words. Parabolic elements are written through their corners,
+ * their mid-side vertices being left unused in points. Lists are formatted
+ * in parallel chunks, written in order.
+ *
+ * @param mesh the mesh
+ * @param directory polyMesh directory, created if needed
+ * @param options output format and default patch name
+ * @throw std::runtime_error If the mesh has no cells, a face is shared by
+ * more than two cells, a count exceeds 32 bits OpenFOAM labels, or a file
+ * cannot be written.
+ */
+void write_foam(const Mesh &mesh,
+                const std::filesystem::path &directory,
+                const FoamOptions &options = FoamOptions());
+
+} // namespace unvpp
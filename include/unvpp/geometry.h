@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Axis aligned box */
+struct BoundingBox {
+  /**
+   * @param lower lower corner, +inf for an empty box
+   * @param upper upper corner, -inf for an empty box
+   */
+  std::array<double, 3> lower;
+  std::array<double, 3> upper;
+};
+
+/* Geometric quantities of the elements of a mesh */
+struct Geometry {
+  /**
+   * @brief Per element arrays are indexed like Mesh::elements().
+   *
+   * @param centroids centroid of each element
+   * @param measures volume of cells, area of faces and length of lines
+   * @param area_vectors area vector of faces (triangles and quads), normal to
+   * the face with the face area as norm, and oriented by the face vertices
+   * ordering. Zero for lines and cells.
+   * @param faces_offsets faces of element e are face_area_vectors[
+   * faces_offsets[e], faces_offsets[e + 1]), only cells have faces
+   * @param face_area_vectors area vector of each face of the cells, pointing
+   * outward of the cell. Faces are listed by their corners: tetra (0 2 1)
+   * (0 1 3) (1 2 3) (0 3 2), wedge (0 2 1) (3 4 5) (0 1 4 3) (1 2 5 4)
+   * (2 0 3 5), hex (0 3 2 1) (4 5 6 7) (0 1 5 4) (1 2 6 5) (2 3 7 6)
+   * (3 0 4 7).
+   * @param bounding_box bounding box of the mesh vertices
+   * @param total_volume sum of the volumes of the cells
+   */
+  std::vector<std::array<double, 3>> centroids;
+  std::vector<double> measures;
+  std::vector<std::array<double, 3>> area_vectors;
+  std::vector<std::size_t> faces_offsets;
+  std::vector<std::array<double, 3>> face_area_vectors;
+  BoundingBox bounding_box;
+  double total_volume;
+};
+
+/**
+ * @brief Compute element centroids, volumes, areas and area vectors, cell
+ * face area vectors, the mesh bounding box and its total volume.
+ *
+ * Elements are processed by type from Mesh::element_blocks(), with fixed
+ * size loops over the corners of each type. Chunks of every block and of the
+ * vertices run in a single parallel pass, which also reduces the bounding box
+ * and the total volume. Parabolic elements are treated as linear ones through
+ * their corners. Cells are split into pyramids from their vertices average to
+ * their faces, so their volumes are positive and their face area vectors point
+ * outward whatever the vertices ordering. Sums are reduced in chunk order, so
+ * results do not depend on the number of threads.
+ *
+ * @param mesh the mesh
+ * @return Geometry
+ */
+auto compute_geometry(const Mesh &mesh) -> Geometry;
+
+} // namespace unvpp
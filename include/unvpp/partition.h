@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Vertices shared by a subdomain with one of its neighbours */
+struct Interface {
+  /**
+   * @brief Shared vertices are local vertex ids, listed in increasing global
+   * id order, so that both sides of an interface list them in the same order.
+   *
+   * @param part id of the neighbouring part
+   * @param vertices local ids of the vertices shared with the neighbour
+   */
+  std::size_t part;
+  std::vector<std::size_t> vertices;
+};
+
+/* A part of a partitioned mesh, with its own local numbering */
+struct Subdomain {
+  /**
+   * @param mesh local mesh, holding the part elements and the vertices they
+   * use. Groups are kept in the same order as in the global mesh, restricted
+   * to local members (and possibly empty).
+   * @param vertices global id of each local vertex, in increasing order
+   * @param elements global id of each local element, in increasing order
+   * @param interfaces vertices shared with each neighbouring part, ordered by
+   * neighbour part id
+   * @param halo_elements global ids of the elements of other parts using an
+   * interface vertex (one layer of ghost elements), in increasing order
+   */
+  Mesh mesh;
+  std::vector<std::size_t> vertices;
+  std::vector<std::size_t> elements;
+  std::vector<Interface> interfaces;
+  std::vector<std::size_t> halo_elements;
+};
+
+/**
+ * @brief Partition mesh elements into balanced parts.
+ *
+ * Cells (the elements of the highest dimension in the mesh) are split by
+ * recursive coordinate bisection of their centroids, then a greedy
+ * refinement pass moves boundary cells to reduce the number of cut faces of
+ * the dual graph while keeping parts balanced. Lower dimension elements
+ * (boundary faces and lines) follow the part of a cell they belong to.
+ *
+ * @param mesh mesh to partition
+ * @param n_parts number of parts
+ * @return std::vector<std::size_t> Part id of each element.
+ */
+auto partition(const Mesh &mesh, std::size_t n_parts)
+    -> std::vector<std::size_t>;
+
+/**
+ * @brief Extract one part of a partitioned mesh as a local mesh.
+ *
+ * @param mesh the partitioned mesh
+ * @param parts part id of each element, see partition()
+ * @param part id of the part to extract
+ * @return Subdomain
+ */
+auto extract_subdomain(const Mesh &mesh,
+                       const std::vector<std::size_t> &parts,
+                       std::size_t part) -> Subdomain;
+
+/**
+ * @brief Extract all parts of a partitioned mesh, in parallel.
+ *
+ * @param mesh the partitioned mesh
+ * @param parts part id of each element, see partition()
+ * @return std::vector<Subdomain> One subdomain per part id, up to the largest
+ * part id in `parts`.
+ */
+auto extract_subdomains(const Mesh &mesh, const std::vector<std::size_t> &parts)
+    -> std::vector<Subdomain>;
+
+} // namespace unvpp
@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Element quality metrics computed by analyze_quality() */
+enum class QualityMetric : std::uint8_t {
+  AspectRatio,
+  Skewness,
+  NonOrthogonality,
+  MinJacobian,
+};
+
+constexpr std::size_t quality_metrics_count = 4;
+
+/* Distribution of a quality metric over fixed bins */
+struct Histogram {
+  /**
+   * @brief Bin i counts the values in [bounds[i], bounds[i + 1]), values
+   * below the first bound or above the last one go to the first or last bin.
+   *
+   * @param bounds bins bounds
+   * @param counts number of values in each bin
+   * @param count number of values
+   * @param min smallest value
+   * @param max largest value
+   * @param sum sum of the values
+   */
+  std::vector<double> bounds;
+  std::vector<std::size_t> counts;
+  std::size_t count{0};
+  double min{0.};
+  double max{0.};
+  double sum{0.};
+};
+
+/* Element with one of the worst values of a metric */
+struct QualityOffender {
+  std::size_t element;
+  double value;
+};
+
+/* Options of analyze_quality() */
+struct QualityOptions {
+  /**
+   * @param n_worst number of worst elements kept for each metric
+   */
+  std::size_t n_worst{10};
+};
+
+/* Quality statistics of a mesh */
+struct QualityReport {
+  /**
+   * @brief Metrics are computed for triangles, quads and cells, lines are
+   * ignored. Non-orthogonality is computed for cells only.
+   *
+   * - aspect ratio: longest over shortest edge length, 1 is best
+   * - skewness: equiangular skewness of the element (or of its worst face),
+   *   0 is best and 1 is degenerate
+   * - non-orthogonality: largest angle in degrees between a face area vector
+   *   and the line joining the centers of the two cells sharing the face, 0
+   *   is best
+   * - min Jacobian: smallest scaled Jacobian at the element corners, 1 is
+   *   best and non-positive values are inverted corners
+   *
+   * @param histograms histogram of each metric for each element type,
+   * indexed as histograms[ElementType][QualityMetric]
+   * @param worst worst elements for each metric, worst first
+   * @param negative_volumes number of cells of each type with a non-positive
+   * corner Jacobian determinant, i.e. inverted or flat cells
+   */
+  std::array<std::array<Histogram, quality_metrics_count>, 6> histograms;
+  std::array<std::vector<QualityOffender>, quality_metrics_count> worst;
+  std::array<std::size_t, 6> negative_volumes{};
+};
+
+/**
+ * @brief Compute quality statistics of the elements of a mesh in parallel.
+ *
+ * Only the histograms and the worst elements are kept, not per element
+ * values, and chunk statistics for a few chunks per thread at a time. The
+ * only extra memory proportional to the mesh is the vertex to elements
+ * adjacency used to find the neighbours of cells.
+ *
+ * @param mesh the mesh
+ * @param options number of worst elements to keep
+ * @return QualityReport
+ */
+auto analyze_quality(const Mesh &mesh,
+                     const QualityOptions &options = QualityOptions())
+    -> QualityReport;
+
+} // namespace unvpp
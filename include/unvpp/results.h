@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Mesh entities a result dataset gives values for */
+enum class ResultLocation : std::uint8_t {
+  Vertices,
+  Elements,
+};
+
+/* UNV result dataset (2414 or 55), stored as one array per component */
+struct ResultDataset {
+  /**
+   * @param label dataset label of 2414 datasets, zero for 55 datasets
+   * @param name dataset name of 2414 datasets, first ID line of 55 datasets
+   * @param location whether values are given at vertices or on elements
+   * @param analysis_type UNV analysis type (0 unknown, 1 static, 2 normal
+   * mode, 4 transient, 5 frequency response, ...)
+   * @param data_characteristic UNV data characteristic (1 scalar, 2 three
+   * DOF vector, 4 symmetric tensor, 5 general tensor, ...)
+   * @param is_complex values are complex, components are then stored as
+   * pairs of real and imaginary parts
+   * @param integer_data analysis type specific integers (load set, time step
+   * number, mode number, ...)
+   * @param real_data analysis type specific reals (time, frequency,
+   * eigenvalue, ...)
+   * @param components one array per component, holding one value per vertex
+   * (or element) in the order of Mesh::vertices() (or Mesh::elements()), and
+   * NaN for the entities the dataset gives no value for
+   */
+  std::size_t label{0};
+  std::string name;
+  ResultLocation location{ResultLocation::Vertices};
+  std::int64_t analysis_type{0};
+  std::int64_t data_characteristic{0};
+  bool is_complex{false};
+  std::vector<std::int64_t> integer_data;
+  std::vector<double> real_data;
+  std::vector<std::vector<double>> components;
+};
+
+/**
+ * @brief Read the result datasets of a UNV file.
+ *
+ * Results of 2414 datasets located at nodes or on elements, and of legacy 55
+ * datasets, are read. Datasets of data at nodes on elements or at points are
+ * skipped. The file must define the mesh vertices and elements before the
+ * results referring to them.
+ *
+ * @param path path to the UNV file
+ * @return std::vector<ResultDataset> Datasets in file order.
+ * @throw std::runtime_error If the file cannot be read, or a result refers to
+ * an unknown vertex or element.
+ */
+auto read_results(const std::filesystem::path &path)
+    -> std::vector<ResultDataset>;
+
+/**
+ * @brief Read the result datasets of a UNV file one at a time.
+ *
+ * Each dataset is passed to `fn` as soon as it is parsed and released after
+ * it returns, so memory holds the mesh numbering and a single dataset (or
+ * time step) at a time. Values of a dataset are parsed in parallel.
+ *
+ * @param path path to the UNV file
+ * @param fn callable invoked with each dataset, in file order
+ * @throw std::runtime_error If the file cannot be read, or a result refers to
+ * an unknown vertex or element.
+ */
+void stream_results(const std::filesystem::path &path,
+                    const std::function<void(ResultDataset &&)> &fn);
+
+} // namespace unvpp
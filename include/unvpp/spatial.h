@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Spatial search structure over mesh vertices and volume cells */
+class SpatialIndex {
+  /**
+   * @brief Bounding volume hierarchies over the vertices and the volume
+   * elements (Tetra, Wedge, Hex) of a mesh, used for nearest-vertex and
+   * point-in-cell queries.
+   *
+   * Both hierarchies are built in parallel when the index is constructed.
+   * All queries are const and do not modify the index, so a single index can
+   * be queried from many threads at the same time. The index keeps a
+   * reference to the mesh, which must outlive it.
+   *
+   * @param mesh the mesh to index
+   */
+public:
+  explicit SpatialIndex(const Mesh &mesh);
+
+  auto nearest_vertex(const std::array<double, 3> &point) const -> std::size_t;
+  auto nearest_vertices(const std::array<double, 3> &point,
+                        std::size_t k) const -> std::vector<std::size_t>;
+  auto nearest_vertices(const std::vector<std::array<double, 3>> &points,
+                        std::size_t k) const -> std::vector<std::size_t>;
+
+  auto locate(const std::array<double, 3> &point) const
+      -> std::optional<std::size_t>;
+  auto locate(const std::vector<std::array<double, 3>> &points) const
+      -> std::vector<std::optional<std::size_t>>;
+
+private:
+  struct Node {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    // leaf: first item and number of items, inner node: index of the left
+    // child (the right child follows it) and a count of zero.
+    std::size_t offset;
+    std::size_t count;
+  };
+
+  struct Tree {
+    std::vector<Node> nodes;
+    std::vector<std::size_t> items;
+  };
+
+  static auto build_tree(const std::vector<std::array<double, 3>> &lower,
+                         const std::vector<std::array<double, 3>> &upper)
+      -> Tree;
+
+  auto cell_contains(std::size_t element_id,
+                     const std::array<double, 3> &point) const -> bool;
+
+  const Mesh *_mesh;
+  Tree _vertices_tree;
+  Tree _cells_tree;
+  std::vector<std::size_t> _cells_ids;
+};
+
+} // namespace unvpp
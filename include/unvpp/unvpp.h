@@ -24,13 +24,19 @@ SOFTWARE.
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include <unvpp/datasets.h>
+#include <unvpp/executor.h>
+
 namespace unvpp {
 
 struct UnitsSystem {
@@ -80,6 +86,27 @@ enum class ElementType : std::uint8_t {
   Hex,
 };
 
+/*
+ * Number of corner vertices of an element type, which is also the vertex
+ * count of its linear variant.
+ */
+constexpr auto corners_count(ElementType type) noexcept -> std::size_t {
+  switch (type) {
+  case ElementType::Line:
+    return 2;
+  case ElementType::Triangle:
+    return 3;
+  case ElementType::Quad:
+  case ElementType::Tetra:
+    return 4;
+  case ElementType::Wedge:
+    return 6;
+  case ElementType::Hex:
+    return 8;
+  }
+  return 0;
+}
+
 /* UNV element data */
 struct Element {
   /**
@@ -110,6 +137,191 @@ enum class GroupType : std::uint8_t {
   Element,
 };
 
+/* Set of element types, stored as a bitmask */
+class ElementTypes {
+public:
+  /* Iterator over the types of the set, in ElementType order */
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType *;
+    using reference = ElementType;
+
+    constexpr Iterator(std::uint8_t mask, std::uint8_t position) noexcept
+        : _mask(mask), _position(position) {
+      skip_missing();
+    }
+
+    constexpr auto operator*() const noexcept -> ElementType {
+      return static_cast<ElementType>(_position);
+    }
+
+    constexpr auto operator++() noexcept -> Iterator & {
+      ++_position;
+      skip_missing();
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> Iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    constexpr auto operator==(const Iterator &other) const noexcept -> bool {
+      return _position == other._position;
+    }
+
+    constexpr auto operator!=(const Iterator &other) const noexcept -> bool {
+      return !(*this == other);
+    }
+
+  private:
+    constexpr void skip_missing() noexcept {
+      while (_position < n_bits && (_mask & (1U << _position)) == 0) {
+        ++_position;
+      }
+    }
+
+    std::uint8_t _mask;
+    std::uint8_t _position;
+  };
+
+  constexpr void insert(ElementType type) noexcept { _mask |= bit(type); }
+
+  constexpr void insert(ElementTypes types) noexcept { _mask |= types._mask; }
+
+  constexpr auto contains(ElementType type) const noexcept -> bool {
+    return (_mask & bit(type)) != 0;
+  }
+
+  constexpr auto size() const noexcept -> std::size_t {
+    std::size_t count = 0;
+    for (auto mask = _mask; mask != 0; mask &= mask - 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  constexpr auto empty() const noexcept -> bool { return _mask == 0; }
+
+  constexpr auto begin() const noexcept -> Iterator { return {_mask, 0}; }
+
+  constexpr auto end() const noexcept -> Iterator { return {_mask, n_bits}; }
+
+  constexpr auto operator==(const ElementTypes &other) const noexcept
+      -> bool {
+    return _mask == other._mask;
+  }
+
+  constexpr auto operator!=(const ElementTypes &other) const noexcept
+      -> bool {
+    return !(*this == other);
+  }
+
+private:
+  static constexpr std::uint8_t n_bits = 8;
+
+  static constexpr auto bit(ElementType type) noexcept -> std::uint8_t {
+    return static_cast<std::uint8_t>(1U << static_cast<std::uint8_t>(type));
+  }
+
+  std::uint8_t _mask{0};
+};
+
+/* Members of a group, stored as runs of consecutive ids */
+class GroupMembers {
+  /**
+   * @brief Ordered list of ids, where each run of consecutive increasing ids
+   * is stored as a single range. Groups covering whole zones of a mesh are
+   * usually a few runs, whatever their number of members. Iterating expands
+   * the ranges on the fly.
+   */
+public:
+  /* Run of `count` consecutive ids starting at `first` */
+  struct Range {
+    std::size_t first;
+    std::size_t count;
+
+    auto operator==(const Range &other) const noexcept -> bool {
+      return first == other.first && count == other.count;
+    }
+  };
+
+  /* Iterator over the members, expanding the ranges */
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::size_t *;
+    using reference = std::size_t;
+
+    Iterator(const Range *range, std::size_t offset) noexcept
+        : _range(range), _offset(offset) {}
+
+    auto operator*() const noexcept -> std::size_t {
+      return _range->first + _offset;
+    }
+
+    auto operator++() noexcept -> Iterator & {
+      if (++_offset == _range->count) {
+        ++_range;
+        _offset = 0;
+      }
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> Iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    auto operator==(const Iterator &other) const noexcept -> bool {
+      return _range == other._range && _offset == other._offset;
+    }
+
+    auto operator!=(const Iterator &other) const noexcept -> bool {
+      return !(*this == other);
+    }
+
+  private:
+    const Range *_range;
+    std::size_t _offset;
+  };
+
+  GroupMembers() = default;
+  GroupMembers(const std::vector<std::size_t> &ids);
+
+  void push_back(std::size_t id);
+  void clear() noexcept;
+
+  auto size() const noexcept -> std::size_t;
+  auto empty() const noexcept -> bool;
+  auto operator[](std::size_t i) const -> std::size_t;
+  auto contains(std::size_t id) const -> bool;
+  auto ranges() const noexcept -> const std::vector<Range> &;
+  auto capacity() const noexcept -> std::size_t;
+  auto to_vector() const -> std::vector<std::size_t>;
+
+  auto begin() const noexcept -> Iterator;
+  auto end() const noexcept -> Iterator;
+
+  auto operator==(const GroupMembers &other) const noexcept -> bool;
+  auto operator!=(const GroupMembers &other) const noexcept -> bool;
+
+private:
+  std::vector<Range> _ranges;
+  // position of the first member of each range
+  std::vector<std::size_t> _offsets;
+  std::size_t _size{0};
+  // ranges are increasing and disjoint, so lookups can bisect
+  bool _sorted{true};
+};
+
 /* UNV group data */
 struct Group {
   /**
@@ -117,24 +329,138 @@ struct Group {
    *
    * @param name name of the group
    * @param type type of the group
-   * @param elements_ids a vector of elements ids defining the group
+   * @param elements_ids ids of the elements (or vertices) defining the group
    */
-  Group(std::string name, GroupType type,
-        std::vector<std::size_t> elements_ids);
+  Group(std::string name, GroupType type, GroupMembers elements_ids);
 
   auto name() const noexcept -> const std::string &;
   auto type() const noexcept -> GroupType;
 
-  auto elements_ids() -> std::vector<std::size_t> &;
-  auto elements_ids() const -> const std::vector<std::size_t> &;
-  auto unique_element_types() const -> const std::unordered_set<ElementType> &;
+  auto elements_ids() const noexcept -> const GroupMembers &;
+  void set_elements_ids(GroupMembers elements_ids);
+  auto unique_element_types() const noexcept -> ElementTypes;
   void add_element_type(ElementType type);
 
 private:
   std::string _name;
   GroupType _type;
-  std::vector<std::size_t> _elements_ids;
-  std::unordered_set<ElementType> _unique_element_types;
+  GroupMembers _elements_ids;
+  ElementTypes _unique_element_types;
+};
+
+/* Elements of a single type, with fixed size connectivity */
+template <ElementType Type>
+struct ElementBlock {
+  /**
+   * @brief Homogeneous array of the elements of one type, see
+   * Mesh::element_blocks(). Parabolic elements keep their corner vertices
+   * only.
+   *
+   * @param vertices_ids corner vertices ids of each element
+   * @param elements_ids index of each element in Mesh::elements()
+   */
+  static constexpr ElementType type = Type;
+  static constexpr std::size_t n_vertices = corners_count(Type);
+
+  std::vector<std::array<std::size_t, n_vertices>> vertices_ids;
+  std::vector<std::size_t> elements_ids;
+};
+
+/* Mesh elements bucketed by type */
+struct ElementBlocks {
+  ElementBlock<ElementType::Line> lines;
+  ElementBlock<ElementType::Triangle> triangles;
+  ElementBlock<ElementType::Quad> quads;
+  ElementBlock<ElementType::Tetra> tetras;
+  ElementBlock<ElementType::Wedge> wedges;
+  ElementBlock<ElementType::Hex> hexes;
+
+  template <ElementType Type>
+  auto get() const noexcept -> const ElementBlock<Type> & {
+    if constexpr (Type == ElementType::Line) {
+      return lines;
+    } else if constexpr (Type == ElementType::Triangle) {
+      return triangles;
+    } else if constexpr (Type == ElementType::Quad) {
+      return quads;
+    } else if constexpr (Type == ElementType::Tetra) {
+      return tetras;
+    } else if constexpr (Type == ElementType::Wedge) {
+      return wedges;
+    } else {
+      return hexes;
+    }
+  }
+
+  template <ElementType Type>
+  auto get() noexcept -> ElementBlock<Type> & {
+    return const_cast<ElementBlock<Type> &>(std::as_const(*this).get<Type>());
+  }
+};
+
+/*
+ * Vertex and element ordering strategies used by Mesh::renumber().
+ * ReverseCuthillMcKee reduces the bandwidth of the vertex graph, Hilbert and
+ * Morton sort vertices and element centroids along a space-filling curve.
+ */
+enum class Ordering : std::uint8_t {
+  ReverseCuthillMcKee,
+  Hilbert,
+  Morton,
+};
+
+/* Vertex and element permutations of a mesh */
+struct Permutation {
+  /**
+   * @brief vertices[new_id] (resp. elements[new_id]) is the previous index of
+   * the vertex (resp. element) moved to new_id.
+   */
+  std::vector<std::size_t> vertices;
+  std::vector<std::size_t> elements;
+};
+
+/* Heap and object bytes held by a mesh, see Mesh::memory_usage() */
+struct MemoryUsage {
+  /**
+   * @param vertices vertices coordinates
+   * @param connectivity elements types and vertices ids
+   * @param groups groups names and members ranges
+   * @param overhead element and group objects headers, and capacity reserved
+   * but unused by all arrays
+   */
+  std::size_t vertices{0};
+  std::size_t connectivity{0};
+  std::size_t groups{0};
+  std::size_t overhead{0};
+
+  auto total() const noexcept -> std::size_t {
+    return vertices + connectivity + groups + overhead;
+  }
+};
+
+/* Hashes of the datasets of a mesh, see Mesh::fingerprint() */
+struct Fingerprint {
+  /**
+   * @param units hash of the units system
+   * @param vertices hash of the vertices coordinates
+   * @param connectivity hash of the elements types and vertices ids
+   * @param groups hash of the groups names, types and members
+   */
+  std::uint64_t units{0};
+  std::uint64_t vertices{0};
+  std::uint64_t connectivity{0};
+  std::uint64_t groups{0};
+
+  auto combined() const noexcept -> std::uint64_t;
+
+  auto operator==(const Fingerprint &other) const noexcept -> bool {
+    return units == other.units && vertices == other.vertices &&
+           connectivity == other.connectivity && groups == other.groups;
+  }
+
+  auto operator!=(const Fingerprint &other) const noexcept -> bool {
+    return !(*this == other);
+  }
 };
 
 /* UNV mesh data */
@@ -158,6 +484,14 @@ public:
   auto groups() const noexcept -> const std::optional<std::vector<Group>> &;
   auto unit_system() const noexcept -> const std::optional<UnitsSystem> &;
 
+  auto element_blocks() const -> ElementBlocks;
+  auto renumber(Ordering ordering) -> Permutation;
+  void permute(const Permutation &permutation);
+  auto merge_vertices(double tolerance) -> std::vector<std::size_t>;
+  auto memory_usage() const noexcept -> MemoryUsage;
+  void compact();
+  auto fingerprint(double tolerance = 0.) const -> Fingerprint;
+
 private:
   std::vector<std::array<double, 3>> _vertices;
   std::optional<std::vector<Element>> _elements{std::nullopt};
@@ -165,6 +499,58 @@ private:
   std::optional<UnitsSystem> _unit_system{std::nullopt};
 };
 
+/* UNV mesh whose datasets are read on first access */
+class LazyMesh {
+  /**
+   * @brief UNV mesh handle with the accessors of Mesh, reading each part of
+   * the file only when it is first accessed.
+   *
+   * The file is scanned for dataset positions without parsing them, and
+   * datasets are parsed on first access: unit_system() reads the units tag
+   * only (scanning the file up to it), vertices() reads the vertices tags,
+   * elements() the elements tags (after the vertices tags, which their
+   * connectivity refers to), and groups() the groups tags, resolving their
+   * members against the ids of vertices and elements records without
+   * parsing coordinates nor connectivity. Each part is read
+   * exactly once, even when accessed concurrently from many threads. Copies
+   * of a LazyMesh share the data read.
+   *
+   * @param path path to the UNV file
+   * @throw std::runtime_error If the file cannot be read.
+   */
+public:
+  explicit LazyMesh(const std::filesystem::path &path);
+
+  auto vertices() const -> const std::vector<std::array<double, 3>> &;
+  auto elements() const -> const std::optional<std::vector<Element>> &;
+  auto groups() const -> const std::optional<std::vector<Group>> &;
+  auto unit_system() const -> const std::optional<UnitsSystem> &;
+
+private:
+  struct State;
+  std::shared_ptr<State> _state;
+};
+
+/* Share of a UNV mesh read by one rank, see read_partition() */
+struct MeshSlice {
+  /**
+   * @param vertices_unv_ids UNV id of each vertex of the slice
+   * @param vertices vertices coordinates of the slice
+   * @param elements_unv_ids UNV id of each element of the slice
+   * @param elements elements of the slice, their vertices ids are UNV ids
+   * since they may refer to vertices of other slices
+   * @param groups groups restricted to the slice members, given as indices in
+   * the slice vertices (vertex groups) or elements (element groups)
+   * @param unit_system units system of the mesh
+   */
+  std::vector<std::size_t> vertices_unv_ids;
+  std::vector<std::array<double, 3>> vertices;
+  std::vector<std::size_t> elements_unv_ids;
+  std::vector<Element> elements;
+  std::vector<Group> groups;
+  std::optional<UnitsSystem> unit_system;
+};
+
 /**
  * @brief Read UNV mesh from file
  *
@@ -173,4 +559,155 @@ private:
  */
 auto read(const std::filesystem::path &path) -> Mesh;
 
+/*
+ * Handling of invalid records by read(). Lenient maps references to unknown
+ * vertices or elements to the first vertex or element, and keeps the last of
+ * records sharing an id. Strict rejects the file instead.
+ */
+enum class Validation : std::uint8_t {
+  Lenient,
+  Strict,
+};
+
+/**
+ * @brief Memory placement of the mesh arrays built by read().
+ *
+ * Default leaves pages to the allocator, so on NUMA machines they all land
+ * on the node of the thread parsing the file. FirstTouch splits the vertices
+ * and elements arrays into n = min(concurrency, bytes / 2 MiB) contiguous
+ * blocks of equal size, inner bounds rounded up to 2 MiB, and task i of the
+ * read executor touches block i first, so that its pages are allocated on
+ * the node running that task. The vertices ids of each element are then
+ * reallocated by the task owning its block. On Linux the arrays are also
+ * advised to transparent huge pages, and the 2 MiB bounds keep each huge
+ * page within one task.
+ *
+ * Pages only end up local to a later solver loop if the executor runs task
+ * i on the same thread (or at least the same node) at every call, as an
+ * executor with threads pinned to cores does. ThreadPool hands out tasks
+ * from a shared counter, so with it pages are spread over the nodes of its
+ * threads without matching any later split.
+ */
+enum class MemoryPlacement : std::uint8_t {
+  Default,
+  FirstTouch,
+};
+
+/* Options of read() */
+struct ReadOptions {
+  /**
+   * @param executor executor running the parallel loops of the read, null
+   * for current_executor(). It must outlive the call.
+   * @param datasets handlers of datasets unvpp does not read, null to skip
+   * them all. It must outlive the call.
+   * @param validation with Validation::Strict, read() throws at the first
+   * duplicate vertex or element id, element with fewer vertices than its
+   * type corners, or reference to an unknown vertex or element, giving its
+   * line in the file. Checks are folded into the ids remapping pass.
+   * @param si_units convert vertices coordinates to meters, dividing them by
+   * the length scale of the units tag (164). The units system of the mesh
+   * then becomes SI (code 1) with a length scale of 1.
+   * @param coordinate_systems express vertices coordinates in the global
+   * frame, applying the coordinate system (2420) each vertex is defined in.
+   * Cartesian, cylindrical (r, theta, z) and spherical (r, theta, phi, with
+   * theta from the z axis) systems are supported, angles in degrees. Systems
+   * not defined in the file are taken as the global frame.
+   * @param placement placement of the vertices and elements arrays in memory,
+   * see MemoryPlacement.
+   */
+  Executor *executor{nullptr};
+  const DatasetRegistry *datasets{nullptr};
+  Validation validation{Validation::Lenient};
+  bool si_units{false};
+  bool coordinate_systems{false};
+  MemoryPlacement placement{MemoryPlacement::Default};
+};
+
+/**
+ * @brief Read UNV mesh from file, with options
+ *
+ * @param path path to the UNV file
+ * @param options read options
+ * @return Mesh
+ */
+auto read(const std::filesystem::path &path, const ReadOptions &options)
+    -> Mesh;
+
+/**
+ * @brief Write a mesh as a UNV file, with units (164), vertices (2411),
+ * elements (2412) and groups (2467) datasets.
+ *
+ * Vertices and elements are labelled from 1 in the mesh order, and reals
+ * are written with 17 significant digits, so that read() gives back the same
+ * mesh. Records are formatted with std::to_chars in parallel chunks, whose
+ * buffers are written in order.
+ *
+ * @param path path to the output UNV file
+ * @param mesh the mesh
+ * @throw std::runtime_error If the file cannot be written or an element has
+ * an unsupported vertices count.
+ */
+void write(const std::filesystem::path &path, const Mesh &mesh);
+
+/* Options of read_many() */
+struct BatchOptions {
+  /**
+   * @param n_threads number of files read concurrently, zero uses the number
+   * of hardware threads
+   * @param max_bytes_in_flight maximum total size of the files being read at
+   * the same time, zero for no limit. Mesh memory grows with file size, so
+   * this bounds peak memory. A file larger than the limit is read alone.
+   * @param executor executor running the reads, and the parallel loops of
+   * each read, null for current_executor(). Zero n_threads then uses its
+   * concurrency.
+   */
+  std::size_t n_threads{0};
+  std::size_t max_bytes_in_flight{0};
+  Executor *executor{nullptr};
+};
+
+/* Outcome of reading one file with read_many() */
+struct ReadResult {
+  /**
+   * @param path path to the UNV file
+   * @param mesh the mesh, if the file was read successfully
+   * @param error the error message otherwise
+   */
+  std::filesystem::path path;
+  std::optional<Mesh> mesh;
+  std::string error;
+};
+
+/**
+ * @brief Read many UNV mesh files concurrently.
+ *
+ * Files are read on a pool of threads, largest files first so that small
+ * files fill the gaps at the end of the batch. Errors are reported per file
+ * and do not stop the batch.
+ *
+ * @param paths paths to the UNV files
+ * @param options threads count and memory bound
+ * @return std::vector<ReadResult> One result per path, in input order.
+ */
+auto read_many(const std::vector<std::filesystem::path> &paths,
+               const BatchOptions &options = BatchOptions())
+    -> std::vector<ReadResult>;
+
+/**
+ * @brief Read one rank share of a UNV mesh file.
+ *
+ * Vertices (2411) and elements (2412) records are split into n_ranks
+ * contiguous slices of balanced sizes, and only the records of `rank` slice
+ * are parsed and stored, the other records are skipped. No communication is
+ * involved, so slices of all ranks can be read in a single process.
+ *
+ * @param path path to the UNV file
+ * @param rank index of the slice to read, in [0, n_ranks)
+ * @param n_ranks number of slices
+ * @return MeshSlice
+ */
+auto read_partition(const std::filesystem::path &path,
+                    std::size_t rank,
+                    std::size_t n_ranks) -> MeshSlice;
+
 } // namespace unvpp
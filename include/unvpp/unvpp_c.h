@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UNVPP_C_H
+#define UNVPP_C_H
+
+/*
+ * C interface of unvpp, callable from C and Fortran (iso_c_binding).
+ *
+ * A mesh read with unvpp_read() owns contiguous arrays: vertices
+ * coordinates, elements connectivity in compressed rows, elements types and
+ * groups members. Accessors return pointers into these arrays, valid until
+ * unvpp_free(), so no copy is made on either side. Ids are 0-based indices.
+ *
+ * No C++ exception crosses this interface: failing functions return a
+ * status, or NULL / 0, and unvpp_last_error() describes the last failure of
+ * the calling thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct unvpp_mesh unvpp_mesh;
+
+typedef enum unvpp_status {
+  UNVPP_OK = 0,
+  UNVPP_ERROR = 1,
+  UNVPP_INVALID_ARGUMENT = 2,
+} unvpp_status;
+
+/* values of unvpp_elements_types() */
+typedef enum unvpp_element_type {
+  UNVPP_LINE = 0,
+  UNVPP_TRIANGLE = 1,
+  UNVPP_QUAD = 2,
+  UNVPP_TETRA = 3,
+  UNVPP_WEDGE = 4,
+  UNVPP_HEX = 5,
+} unvpp_element_type;
+
+typedef enum unvpp_group_kind {
+  UNVPP_VERTEX_GROUP = 0,
+  UNVPP_ELEMENT_GROUP = 1,
+} unvpp_group_kind;
+
+/*
+ * Read a UNV file into a new mesh, stored in *mesh on success and released
+ * with unvpp_free().
+ */
+unvpp_status unvpp_read(const char *path, unvpp_mesh **mesh);
+
+/* Options of unvpp_read_with_options(), all zero for the defaults */
+typedef struct unvpp_read_options {
+  /* nonzero to reject files with invalid records, see unvpp::Validation */
+  int strict;
+  /* nonzero to convert vertices coordinates to meters */
+  int si_units;
+  /* nonzero to express vertices coordinates in the global frame */
+  int coordinate_systems;
+} unvpp_read_options;
+
+/*
+ * Read a UNV file as unvpp_read() does, validating records and transforming
+ * vertices as set in options, which may be NULL.
+ */
+unvpp_status unvpp_read_with_options(const char *path,
+                                     const unvpp_read_options *options,
+                                     unvpp_mesh **mesh);
+
+/* Release a mesh and all its arrays, NULL is ignored. */
+void unvpp_free(unvpp_mesh *mesh);
+
+/* Message of the last failure on the calling thread, empty if none. */
+const char *unvpp_last_error(void);
+
+/* Vertices coordinates as x0 y0 z0 x1 y1 z1 ..., *length = 3 * count. */
+size_t unvpp_vertices_count(const unvpp_mesh *mesh);
+const double *unvpp_vertices(const unvpp_mesh *mesh, size_t *length);
+
+/*
+ * Elements connectivity: the vertices of element i are
+ * ids[offsets[i], offsets[i + 1]), offsets holding count + 1 values.
+ */
+size_t unvpp_elements_count(const unvpp_mesh *mesh);
+const uint8_t *unvpp_elements_types(const unvpp_mesh *mesh, size_t *length);
+const uint64_t *unvpp_elements_offsets(const unvpp_mesh *mesh, size_t *length);
+const uint64_t *unvpp_elements_vertices_ids(const unvpp_mesh *mesh,
+                                            size_t *length);
+
+/*
+ * Groups, indexed in [0, unvpp_groups_count()). Members are vertices or
+ * elements ids depending on the group type.
+ */
+size_t unvpp_groups_count(const unvpp_mesh *mesh);
+const char *unvpp_group_name(const unvpp_mesh *mesh, size_t group);
+unvpp_status unvpp_group_type(const unvpp_mesh *mesh, size_t group,
+                              unvpp_group_kind *type);
+const uint64_t *unvpp_group_members(const unvpp_mesh *mesh, size_t group,
+                                    size_t *length);
+
+/* Units system code and length scale, UNVPP_ERROR if the mesh has none. */
+unvpp_status unvpp_units(const unvpp_mesh *mesh, size_t *code,
+                         double *length_scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UNVPP_C_H */
@@ -0,0 +1,71 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+/* Compression of the arrays of a VTU file */
+enum class VtuCompression : std::uint8_t {
+  None,
+  Zlib,
+};
+
+/* Options of write_vtu() */
+struct VtuOptions {
+  /**
+   * @param compression compression of the appended arrays. Zlib requires
+   * unvpp to be built with zlib.
+   * @param groups export each group as a point data (vertex groups) or cell
+   * data (element groups) array, holding 1 for the group members and 0
+   * elsewhere
+   */
+  VtuCompression compression{VtuCompression::None};
+  bool groups{true};
+};
+
+/**
+ * @brief Write a mesh as a VTK unstructured grid (.vtu) file.
+ *
+ * Arrays are stored as raw binary appended data, in the host byte order.
+ * Linear and parabolic elements map to their linear and quadratic VTK cell
+ * types, with vertices reordered to the VTK conventions. Arrays are split
+ * into fixed size blocks that are encoded (and compressed) in parallel and
+ * written in order, the vertices coordinates being written straight from the
+ * mesh buffer when they are not compressed.
+ *
+ * @param mesh mesh to write
+ * @param path path of the output file
+ * @param options compression and groups export
+ * @throw std::runtime_error If the file cannot be written, an element has an
+ * unsupported vertices count, or compression is not available.
+ */
+void write_vtu(const Mesh &mesh, const std::filesystem::path &path,
+               const VtuOptions &options = VtuOptions());
+
+} // namespace unvpp
@@ -0,0 +1,246 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/unvpp_c.h>
+
+#include <unvpp/compact.h>
+
+#include <array>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* Mesh handle of the C interface, holding the arrays exposed to callers */
+struct unvpp_mesh {
+  unvpp::CompactMesh<std::uint64_t, double> compact;
+};
+
+namespace {
+
+// arrays are handed out as they are stored, without conversion
+static_assert(sizeof(std::array<double, 3>) == 3 * sizeof(double),
+              "vertices must be stored as contiguous triplets");
+static_assert(std::is_same_v<std::underlying_type_t<unvpp::ElementType>,
+                             std::uint8_t>,
+              "element types must be stored as bytes");
+static_assert(static_cast<int>(unvpp::ElementType::Line) == UNVPP_LINE &&
+                  static_cast<int>(unvpp::ElementType::Triangle) ==
+                      UNVPP_TRIANGLE &&
+                  static_cast<int>(unvpp::ElementType::Quad) == UNVPP_QUAD &&
+                  static_cast<int>(unvpp::ElementType::Tetra) == UNVPP_TETRA &&
+                  static_cast<int>(unvpp::ElementType::Wedge) == UNVPP_WEDGE &&
+                  static_cast<int>(unvpp::ElementType::Hex) == UNVPP_HEX,
+              "element types must match their C values");
+
+thread_local std::string last_error;
+
+void set_error(const char *function, const std::string &message) {
+  last_error = std::string("unvpp::") + function + "(): " + message;
+}
+
+auto valid_mesh(const unvpp_mesh *mesh, const char *function) -> bool {
+  if (mesh == nullptr) {
+    set_error(function, "Null mesh");
+    return false;
+  }
+  return true;
+}
+
+auto valid_group(const unvpp_mesh *mesh, std::size_t group,
+                 const char *function) -> bool {
+  if (!valid_mesh(mesh, function)) {
+    return false;
+  }
+  if (group >= mesh->compact.groups.size()) {
+    set_error(function, "Invalid group index " + std::to_string(group));
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+auto set_length(size_t *length, std::size_t value) -> const T * {
+  if (length != nullptr) {
+    *length = value;
+  }
+  return nullptr;
+}
+
+template <typename T, typename U>
+auto array_data(const std::vector<U> &array, std::size_t n_components,
+                size_t *length) -> const T * {
+  set_length<T>(length, array.size() * n_components);
+  return reinterpret_cast<const T *>(array.data());
+}
+
+auto read_mesh(const char *path, const unvpp::ReadOptions &options,
+               unvpp_mesh **mesh, const char *function) -> unvpp_status {
+  *mesh = nullptr;
+  try {
+    *mesh = new unvpp_mesh{unvpp::read_compact<std::uint64_t, double>(
+        std::string(path), options)};
+    return UNVPP_OK;
+  } catch (const std::exception &error) {
+    last_error = error.what();
+  } catch (...) {
+    set_error(function, "Unknown error");
+  }
+  return UNVPP_ERROR;
+}
+
+} // namespace
+
+extern "C" {
+
+unvpp_status unvpp_read(const char *path, unvpp_mesh **mesh) {
+  /**
+   * @brief Read a UNV file into a new mesh with 64-bit ids and double
+   * coordinates, exceptions are turned into statuses.
+   */
+  if (path == nullptr || mesh == nullptr) {
+    set_error(__func__, "Null argument");
+    return UNVPP_INVALID_ARGUMENT;
+  }
+  return read_mesh(path, unvpp::ReadOptions{}, mesh, __func__);
+}
+
+unvpp_status unvpp_read_with_options(const char *path,
+                                     const unvpp_read_options *options,
+                                     unvpp_mesh **mesh) {
+  /**
+   * @brief Read a UNV file as unvpp_read() does, with validation and
+   * vertices transforms, a null options reads with the defaults.
+   */
+  if (path == nullptr || mesh == nullptr) {
+    set_error(__func__, "Null argument");
+    return UNVPP_INVALID_ARGUMENT;
+  }
+
+  unvpp::ReadOptions read_options;
+  if (options != nullptr) {
+    read_options.validation = options->strict != 0
+                                  ? unvpp::Validation::Strict
+                                  : unvpp::Validation::Lenient;
+    read_options.si_units = options->si_units != 0;
+    read_options.coordinate_systems = options->coordinate_systems != 0;
+  }
+  return read_mesh(path, read_options, mesh, __func__);
+}
+
+void unvpp_free(unvpp_mesh *mesh) { delete mesh; }
+
+const char *unvpp_last_error(void) { return last_error.c_str(); }
+
+size_t unvpp_vertices_count(const unvpp_mesh *mesh) {
+  return valid_mesh(mesh, __func__) ? mesh->compact.vertices.size() : 0;
+}
+
+const double *unvpp_vertices(const unvpp_mesh *mesh, size_t *length) {
+  if (!valid_mesh(mesh, __func__)) {
+    return set_length<double>(length, 0);
+  }
+  return array_data<double>(mesh->compact.vertices, 3, length);
+}
+
+size_t unvpp_elements_count(const unvpp_mesh *mesh) {
+  return valid_mesh(mesh, __func__) ? mesh->compact.elements_count() : 0;
+}
+
+const uint8_t *unvpp_elements_types(const unvpp_mesh *mesh, size_t *length) {
+  if (!valid_mesh(mesh, __func__)) {
+    return set_length<uint8_t>(length, 0);
+  }
+  return array_data<uint8_t>(mesh->compact.elements_types, 1, length);
+}
+
+const uint64_t *unvpp_elements_offsets(const unvpp_mesh *mesh,
+                                       size_t *length) {
+  if (!valid_mesh(mesh, __func__)) {
+    return set_length<uint64_t>(length, 0);
+  }
+  return array_data<uint64_t>(mesh->compact.elements_offsets, 1, length);
+}
+
+const uint64_t *unvpp_elements_vertices_ids(const unvpp_mesh *mesh,
+                                            size_t *length) {
+  if (!valid_mesh(mesh, __func__)) {
+    return set_length<uint64_t>(length, 0);
+  }
+  return array_data<uint64_t>(mesh->compact.elements_vertices_ids, 1, length);
+}
+
+size_t unvpp_groups_count(const unvpp_mesh *mesh) {
+  return valid_mesh(mesh, __func__) ? mesh->compact.groups.size() : 0;
+}
+
+const char *unvpp_group_name(const unvpp_mesh *mesh, size_t group) {
+  if (!valid_group(mesh, group, __func__)) {
+    return nullptr;
+  }
+  return mesh->compact.groups[group].name.c_str();
+}
+
+unvpp_status unvpp_group_type(const unvpp_mesh *mesh, size_t group,
+                              unvpp_group_kind *type) {
+  if (!valid_group(mesh, group, __func__)) {
+    return UNVPP_INVALID_ARGUMENT;
+  }
+  if (type == nullptr) {
+    set_error(__func__, "Null argument");
+    return UNVPP_INVALID_ARGUMENT;
+  }
+  *type = mesh->compact.groups[group].type == unvpp::GroupType::Vertex
+              ? UNVPP_VERTEX_GROUP
+              : UNVPP_ELEMENT_GROUP;
+  return UNVPP_OK;
+}
+
+const uint64_t *unvpp_group_members(const unvpp_mesh *mesh, size_t group,
+                                    size_t *length) {
+  if (!valid_group(mesh, group, __func__)) {
+    return set_length<uint64_t>(length, 0);
+  }
+  return array_data<uint64_t>(mesh->compact.groups[group].ids, 1, length);
+}
+
+unvpp_status unvpp_units(const unvpp_mesh *mesh, size_t *code,
+                         double *length_scale) {
+  if (!valid_mesh(mesh, __func__)) {
+    return UNVPP_INVALID_ARGUMENT;
+  }
+  const auto &units = mesh->compact.unit_system;
+  if (!units.has_value()) {
+    set_error(__func__, "The mesh has no units system");
+    return UNVPP_ERROR;
+  }
+  if (code != nullptr) {
+    *code = units->code();
+  }
+  if (length_scale != nullptr) {
+    *length_scale = units->length_scale();
+  }
+  return UNVPP_OK;
+}
+
+} // extern "C"
@@ -55,12 +55,17 @@ constexpr auto UNITS_TAG{"   164"sv};
 constexpr auto VERTICES_TAG{"  2411"sv};
 constexpr auto ELEMENTS_TAG{"  2412"sv};
 constexpr auto DOFS_TAG{"   757"sv};
+constexpr auto RESULTS_TAG{"  2414"sv};
+constexpr auto NODAL_DATA_TAG{"    55"sv};
 
 constexpr std::array<std::string_view, 3> GROUP_TAGS{
     "  2452"sv, "  2467"sv,
     // gmsh exports physical groups using 2477 tag
     "  2477"sv};
 
+// coordinate systems dataset, only read when vertices are transformed
+constexpr std::size_t COORDINATE_SYSTEMS_DATASET{2420};
+
 // group types
 constexpr auto POINT_GROUP{"7"sv};
 constexpr auto ELEMENT_GROUP{"8"sv};
@@ -72,6 +77,8 @@ enum class TagKind : std::uint8_t {
   Elements,
   DOFs,
   Group,
+  Results,
+  NodalData,
   Unsupported,
 };
 
@@ -82,6 +89,8 @@ inline auto tag_kind_from_str(std::string_view tag) -> TagKind {
       {ELEMENTS_TAG, TagKind::Elements},
       {VERTICES_TAG, TagKind::Vertices},
       {DOFS_TAG, TagKind::DOFs},
+      {RESULTS_TAG, TagKind::Results},
+      {NODAL_DATA_TAG, TagKind::NodalData},
       {GROUP_TAGS[0], TagKind::Group},
       {GROUP_TAGS[1], TagKind::Group},
       {GROUP_TAGS[2], TagKind::Group},
@@ -119,6 +128,7 @@ inline auto element_type_from_element_id(std::size_t unv_element_id)
   case 118:
     return ElementType::Tetra;
   case 112:
+  case 113:
     return ElementType::Wedge;
   case 115:
   case 116:
@@ -130,6 +140,61 @@ inline auto element_type_from_element_id(std::size_t unv_element_id)
   }
 }
 
+inline auto corner_position(ElementType element_type,
+                            std::size_t n_vertices,
+                            std::size_t corner) -> std::size_t {
+  /**
+   * @brief Position of a corner vertex in an element vertex list.
+   *
+   * Linear elements list their corners only. Parabolic UNV elements (22/24,
+   * 42/92, 45/95, 118, 113, 116) interleave mid-side vertices, and their
+   * corners are found at the positions below.
+   *
+   * @param element_type type of the element
+   * @param n_vertices number of vertices of the element
+   * @param corner index of the corner, in [0, corners_count(element_type))
+   */
+  if (n_vertices == corners_count(element_type)) {
+    return corner;
+  }
+
+  constexpr std::array<std::size_t, 4> tetra{0, 2, 4, 9};
+  constexpr std::array<std::size_t, 6> wedge{0, 2, 4, 9, 11, 13};
+  constexpr std::array<std::size_t, 8> hex{0, 2, 4, 6, 12, 14, 16, 18};
+
+  switch (element_type) {
+  case ElementType::Line:
+  case ElementType::Triangle:
+  case ElementType::Quad:
+    return 2 * corner;
+  case ElementType::Tetra:
+    return tetra.at(corner);
+  case ElementType::Wedge:
+    return wedge.at(corner);
+  case ElementType::Hex:
+    return hex.at(corner);
+  }
+  return corner;
+}
+
+inline auto element_dimension(ElementType element_type) -> std::size_t {
+  switch (element_type) {
+  case ElementType::Line:
+    return 1;
+  case ElementType::Triangle:
+  case ElementType::Quad:
+    return 2;
+  default:
+    return 3;
+  }
+}
+
+inline auto is_volume_type(ElementType element_type) -> bool {
+  return element_type == ElementType::Tetra ||
+         element_type == ElementType::Wedge ||
+         element_type == ElementType::Hex;
+}
+
 inline auto is_separator(const std::string_view line) -> bool {
   return line.substr(0, 6) == SEPARATOR;
 }
@@ -0,0 +1,281 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/compact.h>
+
+#include <unvpp/executor.h>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "parallel.h"
+#include "reader.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of items handled by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+template <typename Index>
+auto narrow_index(std::size_t value, const char *what) -> Index {
+  /**
+   * @brief Narrow an id or a count to `Index`.
+   *
+   * @throw std::runtime_error If the value does not fit in `Index`.
+   */
+  static_assert(std::is_unsigned_v<Index>, "Index must be unsigned");
+
+  if (value > std::numeric_limits<Index>::max()) {
+    throw std::runtime_error("unvpp::to_compact(): " + std::string(what) +
+                             " " + std::to_string(value) +
+                             " overflows the index type");
+  }
+  return static_cast<Index>(value);
+}
+
+template <typename Real>
+auto narrow_coordinate(double value) -> Real {
+  /**
+   * @brief Narrow a coordinate to `Real`.
+   *
+   * @throw std::runtime_error If a finite value is out of `Real` range.
+   */
+  static_assert(std::is_floating_point_v<Real>, "Real must be floating point");
+
+  if constexpr (sizeof(Real) < sizeof(double)) {
+    if (std::isfinite(value) &&
+        std::abs(value) > std::numeric_limits<Real>::max()) {
+      throw std::runtime_error("unvpp::to_compact(): Coordinate " +
+                               std::to_string(value) +
+                               " overflows the coordinate type");
+    }
+  }
+  return static_cast<Real>(value);
+}
+
+template <typename Real>
+auto narrow_vertices(const std::vector<std::array<double, 3>> &vertices)
+    -> std::vector<std::array<Real, 3>> {
+  std::vector<std::array<Real, 3>> compact(vertices.size());
+
+  parallel_for(vertices.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto v_id = begin; v_id < end; ++v_id) {
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        compact[v_id][axis] = narrow_coordinate<Real>(vertices[v_id][axis]);
+      }
+    }
+  });
+
+  return compact;
+}
+
+template <typename Index, typename Real>
+void narrow_elements(const std::vector<Element> &elements,
+                     std::size_t n_vertices, CompactMesh<Index, Real> &mesh) {
+  narrow_index<Index>(elements.size(), "Elements count");
+
+  mesh.elements_types.resize(elements.size());
+  mesh.elements_offsets.resize(elements.size() + 1);
+
+  // offsets are computed at full width, so that the total connectivity size
+  // is checked before it wraps around
+  std::size_t offset = 0;
+  for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+    mesh.elements_types[e_id] = elements[e_id].type();
+    mesh.elements_offsets[e_id] = narrow_index<Index>(offset, "Connectivity size");
+    offset += elements[e_id].vertices_ids().size();
+  }
+  mesh.elements_offsets.back() = narrow_index<Index>(offset, "Connectivity size");
+  mesh.elements_vertices_ids.resize(offset);
+
+  parallel_for(elements.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto e_id = begin; e_id < end; ++e_id) {
+      auto *ids = mesh.elements_vertices_ids.data() + mesh.elements_offsets[e_id];
+      for (auto v_id : elements[e_id].vertices_ids()) {
+        if (v_id >= n_vertices) {
+          throw std::runtime_error("unvpp::to_compact(): Element " +
+                                   std::to_string(e_id) +
+                                   " refers to unknown vertex " +
+                                   std::to_string(v_id));
+        }
+        *ids++ = static_cast<Index>(v_id);
+      }
+    }
+  });
+}
+
+template <typename Index>
+auto narrow_group(const Group &group) -> CompactGroup<Index> {
+  std::vector<Index> compact;
+  compact.reserve(group.elements_ids().size());
+  for (auto id : group.elements_ids()) {
+    compact.push_back(narrow_index<Index>(id, "Group member"));
+  }
+  return CompactGroup<Index>{group.name(), group.type(), std::move(compact)};
+}
+
+template <typename T>
+void release(std::vector<T> &values) {
+  std::vector<T>().swap(values);
+}
+
+} // namespace
+
+template <typename Index, typename Real>
+auto to_compact(const Mesh &mesh) -> CompactMesh<Index, Real> {
+  /**
+   * @brief Convert a mesh to compact storage.
+   *
+   * @param mesh mesh to convert
+   * @return CompactMesh<Index, Real>
+   * @throw std::runtime_error If an id, a count or a coordinate does not fit
+   * in `Index` or `Real`.
+   */
+  const auto &vertices = mesh.vertices();
+  narrow_index<Index>(vertices.size(), "Vertices count");
+
+  CompactMesh<Index, Real> compact;
+  compact.vertices = narrow_vertices<Real>(vertices);
+  compact.unit_system = mesh.unit_system();
+
+  if (mesh.elements().has_value()) {
+    narrow_elements(*mesh.elements(), vertices.size(), compact);
+  }
+
+  if (mesh.groups().has_value()) {
+    compact.groups.reserve(mesh.groups()->size());
+    for (const auto &group : *mesh.groups()) {
+      compact.groups.push_back(narrow_group<Index>(group));
+    }
+  }
+
+  return compact;
+}
+
+template <typename Index, typename Real>
+auto read_compact(const std::filesystem::path &path)
+    -> CompactMesh<Index, Real> {
+  /**
+   * @brief Read UNV mesh from file into compact storage.
+   *
+   * @param path path to the input UNV mesh file
+   * @return CompactMesh<Index, Real>
+   * @throw std::runtime_error If the file cannot be read, or if an id, a
+   * count or a coordinate does not fit in `Index` or `Real`.
+   */
+  return read_compact<Index, Real>(path, ReadOptions{});
+}
+
+template <typename Index, typename Real>
+auto read_compact(const std::filesystem::path &path, const ReadOptions &options)
+    -> CompactMesh<Index, Real> {
+  /**
+   * @brief Read UNV mesh from file into compact storage, with the executor,
+   * dataset handlers, validation and vertices transforms of the options.
+   *
+   * @param path path to the input UNV mesh file
+   * @param options read options, their placement is not applied
+   * @return CompactMesh<Index, Real>
+   * @throw std::runtime_error If the file cannot be read, or if an id, a
+   * count or a coordinate does not fit in `Index` or `Real`.
+   */
+  auto &executor = options.executor != nullptr ? *options.executor
+                                               : current_executor();
+  ExecutorScope scope(executor);
+
+  check_input_file(path);
+
+  auto reader = Reader(path);
+  reader.set_dataset_handlers(options.datasets);
+  reader.set_validation(options.validation);
+  reader.set_vertices_transform(options.si_units, options.coordinate_systems);
+  reader.read_tags();
+  if (options.si_units || options.coordinate_systems) {
+    reader.transform_vertices();
+  }
+
+  auto &vertices = reader.vertices();
+  auto n_vertices = vertices.size();
+  narrow_index<Index>(n_vertices, "Vertices count");
+
+  CompactMesh<Index, Real> compact;
+  // double coordinates are already in their compact layout
+  if constexpr (std::is_same_v<Real, double>) {
+    compact.vertices = std::move(vertices);
+  } else {
+    compact.vertices = narrow_vertices<Real>(vertices);
+    release(vertices);
+  }
+  compact.unit_system = reader.units();
+
+  auto &groups = reader.groups();
+  compact.groups.reserve(groups.size());
+  for (const auto &group : groups) {
+    compact.groups.push_back(narrow_group<Index>(group));
+  }
+  release(groups);
+
+  narrow_elements(reader.elements(), n_vertices, compact);
+  release(reader.elements());
+
+  return compact;
+}
+
+template auto to_compact<std::uint32_t, float>(const Mesh &)
+    -> CompactMesh<std::uint32_t, float>;
+template auto to_compact<std::uint32_t, double>(const Mesh &)
+    -> CompactMesh<std::uint32_t, double>;
+template auto to_compact<std::uint64_t, float>(const Mesh &)
+    -> CompactMesh<std::uint64_t, float>;
+template auto to_compact<std::uint64_t, double>(const Mesh &)
+    -> CompactMesh<std::uint64_t, double>;
+
+template auto read_compact<std::uint32_t, float>(const std::filesystem::path &)
+    -> CompactMesh<std::uint32_t, float>;
+template auto read_compact<std::uint32_t, double>(const std::filesystem::path &)
+    -> CompactMesh<std::uint32_t, double>;
+template auto read_compact<std::uint64_t, float>(const std::filesystem::path &)
+    -> CompactMesh<std::uint64_t, float>;
+template auto read_compact<std::uint64_t, double>(const std::filesystem::path &)
+    -> CompactMesh<std::uint64_t, double>;
+
+template auto read_compact<std::uint32_t, float>(const std::filesystem::path &,
+                                                 const ReadOptions &)
+    -> CompactMesh<std::uint32_t, float>;
+template auto read_compact<std::uint32_t, double>(const std::filesystem::path &,
+                                                  const ReadOptions &)
+    -> CompactMesh<std::uint32_t, double>;
+template auto read_compact<std::uint64_t, float>(const std::filesystem::path &,
+                                                 const ReadOptions &)
+    -> CompactMesh<std::uint64_t, float>;
+template auto read_compact<std::uint64_t, double>(const std::filesystem::path &,
+                                                  const ReadOptions &)
+    -> CompactMesh<std::uint64_t, double>;
+
+} // namespace unvpp
@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "dataset_index.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace unvpp {
+
+auto index_datasets(const std::filesystem::path &path,
+                    std::optional<TagKind> until)
+    -> std::vector<DatasetPosition> {
+  /**
+   * @brief Find the position of each dataset of a UNV file.
+   *
+   * The file is read in large blocks and scanned for line breaks only, the
+   * content of datasets is not parsed. Outside of a dataset, a line which is
+   * not a separator is a tag line starting a dataset, which then ends at the
+   * next separator.
+   *
+   * @param path path to the UNV file
+   * @param until stop at the first dataset of this kind, if given
+   * @return std::vector<DatasetPosition> Datasets in file order.
+   * @throw std::runtime_error If the file cannot be opened.
+   */
+  constexpr std::size_t block_size = std::size_t{1} << 20;
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("unvpp::index_datasets(): Cannot open file " +
+                             path.string());
+  }
+
+  std::vector<DatasetPosition> datasets;
+  std::vector<char> block(block_size);
+
+  std::string line;            // current line, when split across blocks
+  std::size_t line_number{0};  // number of lines read so far
+  std::streamoff offset{0};    // file offset of the current block
+  bool in_dataset{false};
+
+  // returns true when the scan should stop
+  auto on_line = [&](std::string_view text, std::streamoff next_line) {
+    ++line_number;
+    if (is_separator(text)) {
+      in_dataset = false;
+      return false;
+    }
+    if (in_dataset) {
+      return false;
+    }
+
+    in_dataset = true;
+    auto kind = tag_kind_from_str(text);
+    datasets.push_back(DatasetPosition{kind, next_line, line_number});
+    return until.has_value() && kind == *until;
+  };
+
+  while (file) {
+    file.read(block.data(), static_cast<std::streamsize>(block.size()));
+    auto n_read = static_cast<std::size_t>(file.gcount());
+    if (n_read == 0) {
+      break;
+    }
+
+    std::size_t start = 0;
+    while (start < n_read) {
+      const auto *end = static_cast<const char *>(
+          std::memchr(block.data() + start, '\n', n_read - start));
+      if (end == nullptr) {
+        line.append(block.data() + start, n_read - start);
+        break;
+      }
+
+      auto length = static_cast<std::size_t>(end - (block.data() + start));
+      auto next_line = offset + static_cast<std::streamoff>(start + length + 1);
+      bool stop = false;
+
+      // lines are only copied when they span two blocks
+      if (line.empty()) {
+        stop = on_line(std::string_view(block.data() + start, length), next_line);
+      } else {
+        line.append(block.data() + start, length);
+        stop = on_line(line, next_line);
+        line.clear();
+      }
+
+      if (stop) {
+        return datasets;
+      }
+      start += length + 1;
+    }
+    offset += static_cast<std::streamoff>(n_read);
+  }
+
+  if (!line.empty()) {
+    on_line(line, offset);
+  }
+
+  return datasets;
+}
+
+} // namespace unvpp
@@ -0,0 +1,51 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <filesystem>
+#include <ios>
+#include <optional>
+#include <vector>
+
+#include "common.h"
+
+namespace unvpp {
+
+/* Location of a UNV dataset (tag) in a file */
+struct DatasetPosition {
+  /**
+   * @param kind kind of the dataset tag
+   * @param position position of the line following the tag line
+   * @param line_number number of the tag line
+   */
+  TagKind kind;
+  std::streampos position;
+  std::size_t line_number;
+};
+
+auto index_datasets(const std::filesystem::path &path,
+                    std::optional<TagKind> until = std::nullopt)
+    -> std::vector<DatasetPosition>;
+
+} // namespace unvpp
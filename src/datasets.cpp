@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/datasets.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "common.h"
+
+namespace unvpp {
+
+void DatasetRegistry::add(std::size_t dataset, DatasetHandler handler) {
+  /**
+   * @brief Register the handler of a dataset number, replacing any previous
+   * handler of that number.
+   *
+   * @param dataset UNV dataset number, such as 2420
+   * @param handler callable invoked with the record lines of each dataset of
+   * that number
+   * @throw std::runtime_error If the dataset is read by unvpp, or the handler
+   * is empty.
+   */
+  auto tag = std::to_string(dataset);
+  tag.insert(0, tag.size() < 6 ? 6 - tag.size() : 0, ' ');
+  if (tag_kind_from_str(tag) != TagKind::Unsupported) {
+    throw std::runtime_error("unvpp::DatasetRegistry::add(): Dataset " +
+                             std::to_string(dataset) + " is read by unvpp");
+  }
+
+  if (!handler) {
+    throw std::runtime_error("unvpp::DatasetRegistry::add(): Empty handler "
+                             "for dataset " + std::to_string(dataset));
+  }
+
+  _handlers[dataset] = std::move(handler);
+}
+
+void DatasetRegistry::remove(std::size_t dataset) { _handlers.erase(dataset); }
+
+auto DatasetRegistry::find(std::size_t dataset) const noexcept
+    -> const DatasetHandler * {
+  auto iter = _handlers.find(dataset);
+  return iter != _handlers.end() ? &iter->second : nullptr;
+}
+
+auto DatasetRegistry::empty() const noexcept -> bool {
+  return _handlers.empty();
+}
+
+} // namespace unvpp
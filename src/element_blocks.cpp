@@ -0,0 +1,151 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/unvpp.h>
+
+#include <stdexcept>
+
+#include "common.h"
+#include "parallel.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of element types
+constexpr std::size_t n_types = 6;
+
+// number of elements handled by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+template <ElementType Type>
+void store(ElementBlock<Type> &block, std::size_t i, const Element &element,
+           std::size_t e_id) {
+  const auto &ids = element.vertices_ids();
+  if (ids.size() < block.n_vertices) {
+    throw std::runtime_error(
+        "unvpp::Mesh::element_blocks(): Element " + std::to_string(e_id) +
+        " has " + std::to_string(ids.size()) + " vertices, expected at least " +
+        std::to_string(block.n_vertices));
+  }
+
+  auto &corners = block.vertices_ids[i];
+  for (std::size_t c = 0; c < block.n_vertices; ++c) {
+    corners[c] = ids[corner_position(Type, ids.size(), c)];
+  }
+  block.elements_ids[i] = e_id;
+}
+
+template <ElementType Type>
+void resize(ElementBlock<Type> &block, std::size_t size) {
+  block.vertices_ids.resize(size);
+  block.elements_ids.resize(size);
+}
+
+} // namespace
+
+auto Mesh::element_blocks() const -> ElementBlocks {
+  /**
+   * @brief Copy elements into one homogeneous array per element type.
+   *
+   * Elements are counted per type and per chunk, then each chunk fills its
+   * own ranges of the blocks in parallel, so that elements of a block keep
+   * their order in elements().
+   *
+   * @return ElementBlocks
+   * @throw std::runtime_error If an element has fewer vertices than its type
+   * corners.
+   */
+  ElementBlocks blocks;
+  if (!_elements.has_value()) {
+    return blocks;
+  }
+
+  const auto &elements = *_elements;
+  auto n_chunks = chunks_count(elements.size(), grain);
+  std::vector<std::array<std::size_t, n_types>> cursors(n_chunks);
+
+  parallel_for_chunks(
+      elements.size(), grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &counts = cursors[chunk];
+        counts.fill(0);
+        for (auto e_id = begin; e_id < end; ++e_id) {
+          ++counts[static_cast<std::size_t>(elements[e_id].type())];
+        }
+      });
+
+  // turn chunk counts into chunk first positions in each block
+  std::array<std::size_t, n_types> sizes{};
+  for (auto &counts : cursors) {
+    for (std::size_t type = 0; type < n_types; ++type) {
+      auto count = counts[type];
+      counts[type] = sizes[type];
+      sizes[type] += count;
+    }
+  }
+
+  resize(blocks.lines, sizes[static_cast<std::size_t>(ElementType::Line)]);
+  resize(blocks.triangles,
+         sizes[static_cast<std::size_t>(ElementType::Triangle)]);
+  resize(blocks.quads, sizes[static_cast<std::size_t>(ElementType::Quad)]);
+  resize(blocks.tetras, sizes[static_cast<std::size_t>(ElementType::Tetra)]);
+  resize(blocks.wedges, sizes[static_cast<std::size_t>(ElementType::Wedge)]);
+  resize(blocks.hexes, sizes[static_cast<std::size_t>(ElementType::Hex)]);
+
+  parallel_for_chunks(
+      elements.size(), grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &cursor = cursors[chunk];
+        for (auto e_id = begin; e_id < end; ++e_id) {
+          const auto &element = elements[e_id];
+          auto i = cursor[static_cast<std::size_t>(element.type())]++;
+
+          switch (element.type()) {
+          case ElementType::Line:
+            store(blocks.lines, i, element, e_id);
+            break;
+          case ElementType::Triangle:
+            store(blocks.triangles, i, element, e_id);
+            break;
+          case ElementType::Quad:
+            store(blocks.quads, i, element, e_id);
+            break;
+          case ElementType::Tetra:
+            store(blocks.tetras, i, element, e_id);
+            break;
+          case ElementType::Wedge:
+            store(blocks.wedges, i, element, e_id);
+            break;
+          case ElementType::Hex:
+            store(blocks.hexes, i, element, e_id);
+            break;
+          }
+        }
+      });
+
+  return blocks;
+}
+
+} // namespace unvpp
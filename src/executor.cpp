@@ -0,0 +1,177 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/executor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace unvpp {
+
+namespace {
+
+thread_local Executor *scoped_executor = nullptr;
+
+/* Tasks of one parallel_for() call, shared by the threads running them */
+struct Job {
+  Job(std::size_t n, const std::function<void(std::size_t)> &fn)
+      : n_tasks(n), task(fn) {}
+
+  std::size_t n_tasks;
+  const std::function<void(std::size_t)> &task;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> done{0};
+};
+
+} // namespace
+
+void SequentialExecutor::parallel_for(
+    std::size_t n_tasks, const std::function<void(std::size_t)> &task) {
+  for (std::size_t i = 0; i < n_tasks; ++i) {
+    task(i);
+  }
+}
+
+auto SequentialExecutor::concurrency() const noexcept -> std::size_t {
+  return 1;
+}
+
+struct ThreadPool::State {
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  std::deque<std::shared_ptr<Job>> jobs;
+  std::vector<std::thread> threads;
+  bool stop{false};
+
+  void work(Job &job) {
+    /**
+     * @brief Run tasks of a job until none is left to start.
+     */
+    for (auto i = job.next.fetch_add(1); i < job.n_tasks;
+         i = job.next.fetch_add(1)) {
+      job.task(i);
+      if (job.done.fetch_add(1) + 1 == job.n_tasks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.notify_all();
+      }
+    }
+  }
+
+  void worker() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wake.wait(lock, [this]() { return stop || !jobs.empty(); });
+      if (stop) {
+        return;
+      }
+
+      // jobs whose tasks have all started are left to their caller
+      auto job = jobs.front();
+      if (job->next.load() >= job->n_tasks) {
+        jobs.pop_front();
+        continue;
+      }
+
+      lock.unlock();
+      work(*job);
+      lock.lock();
+    }
+  }
+};
+
+ThreadPool::ThreadPool(std::size_t n_threads)
+    : _state(std::make_unique<State>()) {
+  if (n_threads == 0) {
+    n_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  // the thread calling parallel_for() runs tasks too
+  _state->threads.reserve(n_threads - 1);
+  for (std::size_t t = 1; t < n_threads; ++t) {
+    _state->threads.emplace_back([state = _state.get()]() { state->worker(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->stop = true;
+  }
+  _state->wake.notify_all();
+  for (auto &thread : _state->threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::parallel_for(std::size_t n_tasks,
+                              const std::function<void(std::size_t)> &task) {
+  if (n_tasks == 0) {
+    return;
+  }
+
+  auto job = std::make_shared<Job>(n_tasks, task);
+  if (n_tasks > 1 && !_state->threads.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      _state->jobs.push_back(job);
+    }
+    _state->wake.notify_all();
+  }
+
+  _state->work(*job);
+
+  std::unique_lock<std::mutex> lock(_state->mutex);
+  _state->finished.wait(lock, [&]() { return job->done.load() == n_tasks; });
+  auto iter = std::find(_state->jobs.begin(), _state->jobs.end(), job);
+  if (iter != _state->jobs.end()) {
+    _state->jobs.erase(iter);
+  }
+}
+
+auto ThreadPool::concurrency() const noexcept -> std::size_t {
+  return _state->threads.size() + 1;
+}
+
+auto default_executor() -> Executor & {
+  static ThreadPool pool;
+  return pool;
+}
+
+auto current_executor() -> Executor & {
+  return scoped_executor != nullptr ? *scoped_executor : default_executor();
+}
+
+ExecutorScope::ExecutorScope(Executor &executor) noexcept
+    : _previous(scoped_executor) {
+  scoped_executor = &executor;
+}
+
+ExecutorScope::~ExecutorScope() { scoped_executor = _previous; }
+
+} // namespace unvpp
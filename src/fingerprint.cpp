@@ -0,0 +1,191 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/unvpp.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of vertices or elements hashed by one parallel chunk
+constexpr std::size_t grain = std::size_t{1} << 14;
+
+constexpr std::uint64_t prime_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t prime_2 = 0xC2B2AE3D27D4EB4FULL;
+
+constexpr auto mix(std::uint64_t hash, std::uint64_t value) noexcept
+    -> std::uint64_t {
+  /**
+   * @brief Fold a value into a hash, with the round of xxHash64.
+   */
+  hash += value * prime_2;
+  hash = (hash << 31) | (hash >> 33);
+  return hash * prime_1;
+}
+
+constexpr auto finalize(std::uint64_t hash) noexcept -> std::uint64_t {
+  hash ^= hash >> 33;
+  hash *= prime_2;
+  hash ^= hash >> 29;
+  hash *= prime_1;
+  return hash ^ (hash >> 32);
+}
+
+auto double_bits(double value) noexcept -> std::uint64_t {
+  // -0 and +0 hash alike
+  value = value == 0. ? 0. : value;
+  std::uint64_t bits{0};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+auto string_hash(std::uint64_t hash, const std::string &text) noexcept
+    -> std::uint64_t {
+  hash = mix(hash, text.size());
+  for (auto c : text) {
+    hash = mix(hash, static_cast<unsigned char>(c));
+  }
+  return hash;
+}
+
+template <typename HashItem>
+auto chunked_hash(std::size_t n, HashItem &&hash_item) -> std::uint64_t {
+  /**
+   * @brief Hash n items, in chunks hashed in parallel then folded in order,
+   * so the hash does not depend on the number of threads.
+   *
+   * @param n number of items
+   * @param hash_item callable invoked as hash_item(hash, i), returning the
+   * hash with item i folded in
+   */
+  std::vector<std::uint64_t> chunks(chunks_count(n, grain));
+  parallel_for_chunks(
+      n, grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::uint64_t hash = prime_1 ^ chunk;
+        for (auto i = begin; i < end; ++i) {
+          hash = hash_item(hash, i);
+        }
+        chunks[chunk] = hash;
+      });
+
+  auto hash = mix(prime_2, n);
+  for (auto chunk : chunks) {
+    hash = mix(hash, chunk);
+  }
+  return finalize(hash);
+}
+
+} // namespace
+
+auto Fingerprint::combined() const noexcept -> std::uint64_t {
+  /**
+   * @brief Single hash of all the datasets, e.g. as a cache key.
+   */
+  auto hash = mix(mix(prime_1, units), vertices);
+  return finalize(mix(mix(hash, connectivity), groups));
+}
+
+auto Mesh::fingerprint(double tolerance) const -> Fingerprint {
+  /**
+   * @brief Hash each dataset of the mesh.
+   *
+   * Vertices and elements are hashed in parallel chunks whose hashes are
+   * folded in order, so fingerprints do not depend on the number of threads
+   * and equal meshes have equal fingerprints. Hashes depend on the order of
+   * vertices, elements and groups. They are not cryptographic.
+   *
+   * @param tolerance with a positive tolerance, coordinates are rounded to
+   * the nearest multiple of it before hashing, so that vertices differing by
+   * rounding noise hash alike. Values close to the middle of two multiples
+   * may still round apart. With zero, coordinates are hashed exactly.
+   * @return Fingerprint
+   * @throw std::runtime_error If tolerance is negative or not finite.
+   */
+  if (!(tolerance >= 0.) || !std::isfinite(tolerance)) {
+    throw std::runtime_error("unvpp::Mesh::fingerprint(): Invalid tolerance " +
+                             std::to_string(tolerance));
+  }
+
+  Fingerprint fingerprint;
+
+  if (_unit_system.has_value()) {
+    fingerprint.units =
+        finalize(mix(mix(prime_1, _unit_system->code()),
+                     double_bits(_unit_system->length_scale())));
+  }
+
+  auto coordinate = [tolerance](double value) -> std::uint64_t {
+    if (tolerance == 0.) {
+      return double_bits(value);
+    }
+    return static_cast<std::uint64_t>(std::llround(value / tolerance));
+  };
+  fingerprint.vertices =
+      chunked_hash(_vertices.size(), [&](std::uint64_t hash, std::size_t i) {
+        for (auto x : _vertices[i]) {
+          hash = mix(hash, coordinate(x));
+        }
+        return hash;
+      });
+
+  if (_elements.has_value()) {
+    const auto &elements = _elements.value();
+    fingerprint.connectivity =
+        chunked_hash(elements.size(), [&](std::uint64_t hash, std::size_t i) {
+          const auto &ids = elements[i].vertices_ids();
+          hash = mix(hash, static_cast<std::uint64_t>(elements[i].type()));
+          hash = mix(hash, ids.size());
+          for (auto id : ids) {
+            hash = mix(hash, id);
+          }
+          return hash;
+        });
+  }
+
+  if (_groups.has_value()) {
+    // groups members are stored as ranges, which are few
+    auto hash = mix(prime_2, _groups->size());
+    for (const auto &group : _groups.value()) {
+      hash = string_hash(hash, group.name());
+      hash = mix(hash, static_cast<std::uint64_t>(group.type()));
+      hash = mix(hash, group.elements_ids().size());
+      for (const auto &range : group.elements_ids().ranges()) {
+        hash = mix(mix(hash, range.first), range.count);
+      }
+    }
+    fingerprint.groups = finalize(hash);
+  }
+
+  return fingerprint;
+}
+
+} // namespace unvpp
@@ -0,0 +1,542 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/foam.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common.h"
+#include "format.h"
+#include "parallel.h"
+#include "shapes.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of items handled by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+constexpr auto no_id = std::numeric_limits<std::size_t>::max();
+constexpr auto max_label =
+    static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+
+// vertices of a face, triangles leave the last one to no_id
+using FaceVertices = std::array<std::size_t, 4>;
+
+/* Face of a cell, as its position in cell_faces() */
+struct FaceRef {
+  std::size_t cell;
+  std::uint8_t face;
+};
+
+/* Face of a cell with its sorted vertices, equal for both sides of a face */
+struct CellFace {
+  FaceVertices key;
+  FaceRef ref;
+};
+
+/* Face between two cells, seen from its owner */
+struct InternalFace {
+  FaceRef owner;
+  std::size_t neighbour;
+};
+
+/* Boundary face in a patch */
+struct BoundaryFace {
+  std::size_t patch;
+  FaceRef owner;
+};
+
+auto faces_count(ElementType type) -> std::size_t {
+  switch (type) {
+  case ElementType::Tetra:
+    return cell_faces<ElementType::Tetra>().size();
+  case ElementType::Wedge:
+    return cell_faces<ElementType::Wedge>().size();
+  default:
+    return cell_faces<ElementType::Hex>().size();
+  }
+}
+
+auto local_face(ElementType type, std::size_t face) -> LocalFace {
+  switch (type) {
+  case ElementType::Tetra:
+    return cell_faces<ElementType::Tetra>()[face];
+  case ElementType::Wedge:
+    return cell_faces<ElementType::Wedge>()[face];
+  default:
+    return cell_faces<ElementType::Hex>()[face];
+  }
+}
+
+auto face_vertices(const Element &element, std::size_t face) -> FaceVertices {
+  /**
+   * @brief Vertices of a face of a cell, ordered outward of the cell.
+   */
+  const auto &ids = element.vertices_ids();
+  auto local = local_face(element.type(), face);
+  FaceVertices vertices{no_id, no_id, no_id, no_id};
+  for (std::size_t c = 0; c < local.n_corners; ++c) {
+    vertices[c] =
+        ids[corner_position(element.type(), ids.size(), local.corners[c])];
+  }
+  return vertices;
+}
+
+auto sorted(FaceVertices vertices) -> FaceVertices {
+  std::sort(vertices.begin(), vertices.end());
+  return vertices;
+}
+
+auto face_size(const FaceVertices &vertices) -> std::size_t {
+  return vertices[3] == no_id ? 3 : 4;
+}
+
+auto cells_faces(const std::vector<Element> &elements,
+                 const std::vector<std::size_t> &cells)
+    -> std::vector<CellFace> {
+  /**
+   * @brief Faces of all cells, sorted by vertices so that both sides of an
+   * internal face are next to each other, the lowest cell first.
+   */
+  std::vector<std::size_t> offsets(cells.size() + 1, 0);
+  for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+    offsets[cell + 1] = offsets[cell] + faces_count(elements[cells[cell]].type());
+  }
+
+  std::vector<CellFace> faces(offsets.back());
+  parallel_for(cells.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto cell = begin; cell < end; ++cell) {
+      const auto &element = elements[cells[cell]];
+      for (auto face = offsets[cell]; face < offsets[cell + 1]; ++face) {
+        auto local = static_cast<std::uint8_t>(face - offsets[cell]);
+        faces[face] = {sorted(face_vertices(element, local)), {cell, local}};
+      }
+    }
+  });
+
+  parallel_sort(faces.begin(), faces.end(),
+                [](const CellFace &a, const CellFace &b) {
+                  if (a.key != b.key) {
+                    return a.key < b.key;
+                  }
+                  if (a.ref.cell != b.ref.cell) {
+                    return a.ref.cell < b.ref.cell;
+                  }
+                  return a.ref.face < b.ref.face;
+                });
+  return faces;
+}
+
+void split_faces(const std::vector<CellFace> &faces,
+                 std::vector<InternalFace> &internal,
+                 std::vector<CellFace> &boundary) {
+  /**
+   * @brief Pair the sides of internal faces, and collect boundary faces, in
+   * parallel chunks concatenated in chunk order.
+   */
+  auto n_chunks = chunks_count(faces.size(), grain);
+  std::vector<std::vector<InternalFace>> chunks_internal(n_chunks);
+  std::vector<std::vector<CellFace>> chunks_boundary(n_chunks);
+
+  parallel_for_chunks(
+      faces.size(), grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        // faces are handled by the chunk where their first side lies
+        auto i = begin;
+        while (i > 0 && i < end && faces[i].key == faces[i - 1].key) {
+          ++i;
+        }
+        while (i < end) {
+          auto next = i + 1;
+          while (next < faces.size() && faces[next].key == faces[i].key) {
+            ++next;
+          }
+          if (next - i > 2) {
+            throw std::runtime_error(
+                "unvpp::write_foam(): A face is shared by more than two cells");
+          }
+          if (next - i == 2) {
+            chunks_internal[chunk].push_back(
+                {faces[i].ref, faces[i + 1].ref.cell});
+          } else {
+            chunks_boundary[chunk].push_back(faces[i]);
+          }
+          i = next;
+        }
+      });
+
+  for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+    internal.insert(internal.end(), chunks_internal[chunk].begin(),
+                    chunks_internal[chunk].end());
+    boundary.insert(boundary.end(), chunks_boundary[chunk].begin(),
+                    chunks_boundary[chunk].end());
+    chunks_internal[chunk] = {};
+    chunks_boundary[chunk] = {};
+  }
+}
+
+auto foam_word(const std::string &name) -> std::string {
+  /**
+   * @brief Replace the characters OpenFOAM words cannot hold by underscores.
+   */
+  std::string word = name.empty() ? std::string("group") : name;
+  for (auto &c : word) {
+    if (std::isspace(static_cast<unsigned char>(c)) != 0 ||
+        std::strchr("\"'/\\;{}()[]#$", c) != nullptr) {
+      c = '_';
+    }
+  }
+  return word;
+}
+
+void append_label(std::string &out, std::size_t value) {
+  auto label = static_cast<std::int32_t>(value);
+  out.append(reinterpret_cast<const char *>(&label), sizeof(label));
+}
+
+template <typename Fn>
+void write_list(std::ofstream &file, FoamFormat format, std::size_t n,
+                Fn &&append) {
+  /**
+   * @brief Write a list of n items, one per line in ascii, or the items
+   * bytes between parentheses in binary.
+   */
+  file << n << (format == FoamFormat::Ascii ? "\n(\n" : "\n(");
+  write_formatted(file, n, grain, append);
+  file << ")\n";
+}
+
+template <typename Fn>
+void write_labels(std::ofstream &file, FoamFormat format, std::size_t n,
+                  Fn &&label) {
+  write_list(file, format, n, [&](std::size_t i, std::string &out) {
+    if (format == FoamFormat::Ascii) {
+      append_number(out, label(i));
+      out += '\n';
+    } else {
+      append_label(out, label(i));
+    }
+  });
+}
+
+auto is_little_endian() -> bool {
+  std::uint16_t one = 1;
+  unsigned char first_byte{};
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+auto open_file(const std::filesystem::path &directory,
+               const std::string &object, const std::string &class_name,
+               FoamFormat format, const std::string &note = "")
+    -> std::ofstream {
+  /**
+   * @brief Open a polyMesh file and write its FoamFile header.
+   */
+  auto path = directory / object;
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("unvpp::write_foam(): Cannot open " +
+                             path.string() + " for writing");
+  }
+
+  file << "FoamFile\n{\n"
+       << "    version     2.0;\n"
+       << "    format      "
+       << (format == FoamFormat::Ascii ? "ascii" : "binary") << ";\n"
+       << "    arch        \"" << (is_little_endian() ? "LSB" : "MSB")
+       << ";label=32;scalar=64\";\n"
+       << "    class       " << class_name << ";\n";
+  if (!note.empty()) {
+    file << "    note        \"" << note << "\";\n";
+  }
+  file << "    location    \"constant/polyMesh\";\n"
+       << "    object      " << object << ";\n"
+       << "}\n\n";
+  return file;
+}
+
+void close_file(std::ofstream &file, const std::string &object) {
+  file.close();
+  if (!file) {
+    throw std::runtime_error("unvpp::write_foam(): Failed to write " + object);
+  }
+}
+
+} // namespace
+
+void write_foam(const Mesh &mesh, const std::filesystem::path &directory,
+                const FoamOptions &options) {
+  /**
+   * @brief Write a mesh as an OpenFOAM polyMesh directory.
+   *
+   * @param mesh the mesh
+   * @param directory polyMesh directory, created if needed
+   * @param options output format and default patch name
+   */
+  static const std::vector<Group> no_groups;
+  const auto &vertices = mesh.vertices();
+  const auto &groups = mesh.groups().has_value() ? *mesh.groups() : no_groups;
+
+  std::vector<std::size_t> cells;
+  std::vector<std::size_t> cell_of;
+  if (mesh.elements().has_value()) {
+    cell_of.assign(mesh.elements()->size(), no_id);
+    for (std::size_t e_id = 0; e_id < mesh.elements()->size(); ++e_id) {
+      if (is_volume_type((*mesh.elements())[e_id].type())) {
+        cell_of[e_id] = cells.size();
+        cells.push_back(e_id);
+      }
+    }
+  }
+  if (cells.empty()) {
+    throw std::runtime_error("unvpp::write_foam(): The mesh has no cells");
+  }
+  const auto &elements = *mesh.elements();
+
+  std::vector<InternalFace> internal;
+  std::vector<CellFace> unpaired;
+  split_faces(cells_faces(elements, cells), internal, unpaired);
+
+  // OpenFOAM needs internal faces ordered by owner, then by neighbour
+  parallel_sort(internal.begin(), internal.end(),
+                [](const InternalFace &a, const InternalFace &b) {
+                  if (a.owner.cell != b.owner.cell) {
+                    return a.owner.cell < b.owner.cell;
+                  }
+                  if (a.neighbour != b.neighbour) {
+                    return a.neighbour < b.neighbour;
+                  }
+                  return a.owner.face < b.owner.face;
+                });
+
+  // patches are the element groups of faces, looked up by sorted vertices
+  std::vector<std::string> patches_names;
+  std::vector<std::pair<FaceVertices, std::size_t>> patches_faces;
+  for (const auto &group : groups) {
+    if (group.type() != GroupType::Element ||
+        !(group.unique_element_types().contains(ElementType::Triangle) ||
+          group.unique_element_types().contains(ElementType::Quad))) {
+      continue;
+    }
+    for (auto e_id : group.elements_ids()) {
+      const auto &element = elements[e_id];
+      if (element.type() != ElementType::Triangle &&
+          element.type() != ElementType::Quad) {
+        continue;
+      }
+      const auto &ids = element.vertices_ids();
+      FaceVertices face{no_id, no_id, no_id, no_id};
+      for (std::size_t c = 0; c < corners_count(element.type()); ++c) {
+        face[c] = ids[corner_position(element.type(), ids.size(), c)];
+      }
+      patches_faces.emplace_back(sorted(face), patches_names.size());
+    }
+    patches_names.push_back(foam_word(group.name()));
+  }
+  parallel_sort(patches_faces.begin(), patches_faces.end(),
+                [](const auto &a, const auto &b) { return a < b; });
+
+  auto default_patch = patches_names.size();
+  std::vector<BoundaryFace> boundary(unpaired.size());
+  parallel_for(unpaired.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      auto match = std::lower_bound(
+          patches_faces.begin(), patches_faces.end(),
+          std::make_pair(unpaired[i].key, std::size_t{0}));
+      auto patch = match != patches_faces.end() && match->first == unpaired[i].key
+                       ? match->second
+                       : default_patch;
+      boundary[i] = {patch, unpaired[i].ref};
+    }
+  });
+  unpaired = {};
+  patches_faces = {};
+
+  parallel_sort(boundary.begin(), boundary.end(),
+                [](const BoundaryFace &a, const BoundaryFace &b) {
+                  if (a.patch != b.patch) {
+                    return a.patch < b.patch;
+                  }
+                  if (a.owner.cell != b.owner.cell) {
+                    return a.owner.cell < b.owner.cell;
+                  }
+                  return a.owner.face < b.owner.face;
+                });
+
+  std::vector<std::size_t> patches_sizes(default_patch + 1, 0);
+  for (const auto &face : boundary) {
+    ++patches_sizes[face.patch];
+  }
+  patches_names.push_back(foam_word(options.default_patch));
+
+  auto n_internal = internal.size();
+  auto n_faces = n_internal + boundary.size();
+  if (vertices.size() > max_label || 4 * n_faces > max_label) {
+    throw std::runtime_error(
+        "unvpp::write_foam(): The mesh is too large for 32 bits labels");
+  }
+
+  auto owner = [&](std::size_t face) -> const FaceRef & {
+    return face < n_internal ? internal[face].owner
+                             : boundary[face - n_internal].owner;
+  };
+  auto face_of = [&](std::size_t face) {
+    const auto &ref = owner(face);
+    return face_vertices(elements[cells[ref.cell]], ref.face);
+  };
+
+  std::filesystem::create_directories(directory);
+  auto format = options.format;
+
+  auto points = open_file(directory, "points", "vectorField", format);
+  if (format == FoamFormat::Ascii) {
+    write_list(points, format, vertices.size(),
+               [&](std::size_t v_id, std::string &out) {
+                 const auto &vertex = vertices[v_id];
+                 out += '(';
+                 append_number(out, vertex[0]);
+                 out += ' ';
+                 append_number(out, vertex[1]);
+                 out += ' ';
+                 append_number(out, vertex[2]);
+                 out += ")\n";
+               });
+  } else {
+    points << vertices.size() << "\n(";
+    points.write(reinterpret_cast<const char *>(vertices.data()),
+                 static_cast<std::streamsize>(vertices.size() *
+                                              sizeof(vertices[0])));
+    points << ")\n";
+  }
+  close_file(points, "points");
+
+  if (format == FoamFormat::Ascii) {
+    auto faces = open_file(directory, "faces", "faceList", format);
+    write_list(faces, format, n_faces, [&](std::size_t face, std::string &out) {
+      auto ids = face_of(face);
+      auto n = face_size(ids);
+      append_number(out, n);
+      for (std::size_t c = 0; c < n; ++c) {
+        out += c == 0 ? '(' : ' ';
+        append_number(out, ids[c]);
+      }
+      out += ")\n";
+    });
+    close_file(faces, "faces");
+  } else {
+    // binary faces are written as offsets then vertices of a faceCompactList
+    auto faces = open_file(directory, "faces", "faceCompactList", format);
+    std::vector<std::size_t> offsets(n_faces + 1, 0);
+    parallel_for(n_faces, grain, [&](std::size_t begin, std::size_t end) {
+      for (auto face = begin; face < end; ++face) {
+        offsets[face + 1] = face_size(face_of(face));
+      }
+    });
+    for (std::size_t face = 0; face < n_faces; ++face) {
+      offsets[face + 1] += offsets[face];
+    }
+    write_labels(faces, format, offsets.size(),
+                 [&](std::size_t i) { return offsets[i]; });
+    faces << "\n" << offsets.back() << "\n(";
+    write_formatted(faces, n_faces, grain, [&](std::size_t face, std::string &out) {
+      auto ids = face_of(face);
+      for (std::size_t c = 0; c < face_size(ids); ++c) {
+        append_label(out, ids[c]);
+      }
+    });
+    faces << ")\n";
+    close_file(faces, "faces");
+  }
+
+  auto note = "nPoints:" + std::to_string(vertices.size()) +
+              " nCells:" + std::to_string(cells.size()) +
+              " nFaces:" + std::to_string(n_faces) +
+              " nInternalFaces:" + std::to_string(n_internal);
+
+  auto owners = open_file(directory, "owner", "labelList", format, note);
+  write_labels(owners, format, n_faces,
+               [&](std::size_t face) { return owner(face).cell; });
+  close_file(owners, "owner");
+
+  auto neighbours = open_file(directory, "neighbour", "labelList", format, note);
+  write_labels(neighbours, format, n_internal,
+               [&](std::size_t face) { return internal[face].neighbour; });
+  close_file(neighbours, "neighbour");
+
+  // the default patch is only written when some faces are left in it
+  auto n_patches = patches_sizes[default_patch] > 0 ? default_patch + 1
+                                                    : default_patch;
+  auto boundary_file =
+      open_file(directory, "boundary", "polyBoundaryMesh", format);
+  boundary_file << n_patches << "\n(\n";
+  auto start = n_internal;
+  for (std::size_t patch = 0; patch < n_patches; ++patch) {
+    boundary_file << "    " << patches_names[patch] << "\n    {\n"
+                  << "        type            patch;\n"
+                  << "        nFaces          " << patches_sizes[patch] << ";\n"
+                  << "        startFace       " << start << ";\n    }\n";
+    start += patches_sizes[patch];
+  }
+  boundary_file << ")\n";
+  close_file(boundary_file, "boundary");
+
+  auto zones = open_file(directory, "cellZones", "regIOobject", format);
+  std::vector<std::pair<std::string, std::vector<std::size_t>>> cell_zones;
+  for (const auto &group : groups) {
+    if (group.type() != GroupType::Element) {
+      continue;
+    }
+    std::vector<std::size_t> zone_cells;
+    for (auto e_id : group.elements_ids()) {
+      if (cell_of[e_id] != no_id) {
+        zone_cells.push_back(cell_of[e_id]);
+      }
+    }
+    if (!zone_cells.empty()) {
+      cell_zones.emplace_back(foam_word(group.name()), std::move(zone_cells));
+    }
+  }
+  zones << cell_zones.size() << "\n(\n";
+  for (const auto &[name, zone_cells] : cell_zones) {
+    zones << name << "\n{\n    type cellZone;\ncellLabels List<label> ";
+    write_labels(zones, format, zone_cells.size(),
+                 [&](std::size_t i) { return zone_cells[i]; });
+    zones << ";\n}\n";
+  }
+  zones << ")\n";
+  close_file(zones, "cellZones");
+}
+
+} // namespace unvpp
@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+
+namespace unvpp {
+
+template <typename T>
+inline void append_number(std::string &out, T value) {
+  /**
+   * @brief Append the shortest representation of a number that reads back
+   * to the same value.
+   */
+  std::array<char, 32> buffer{};
+  auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                              value);
+  out.append(buffer.data(), result.ptr);
+}
+
+template <typename Fn>
+void write_formatted(std::ofstream &file, std::size_t n, std::size_t grain,
+                     Fn &&append) {
+  /**
+   * @brief Write n items, where `append(i, out)` appends the text or bytes
+   * of item i to `out`.
+   *
+   * Chunks of `grain` items are formatted in parallel by batches of a few
+   * chunks per thread, then their buffers are written in order, so output
+   * does not depend on the number of threads and memory stays bounded.
+   *
+   * @param file output file
+   * @param n number of items
+   * @param grain number of items per chunk
+   * @param append callable invoked as append(i, std::string &out)
+   */
+  constexpr std::size_t chunks_per_thread = 4;
+  auto batch_size =
+      grain * chunks_per_thread * current_executor().concurrency();
+  std::vector<std::string> buffers(
+      chunks_count(std::min(n, batch_size), grain));
+
+  for (std::size_t first = 0; first < n; first += batch_size) {
+    auto n_batch = std::min(batch_size, n - first);
+    parallel_for_chunks(
+        n_batch, grain,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+          auto &buffer = buffers[chunk];
+          buffer.clear();
+          for (auto i = first + begin; i < first + end; ++i) {
+            append(i, buffer);
+          }
+        });
+    for (std::size_t chunk = 0; chunk < chunks_count(n_batch, grain);
+         ++chunk) {
+      file.write(buffers[chunk].data(),
+                 static_cast<std::streamsize>(buffers[chunk].size()));
+    }
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,260 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/geometry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+#include "parallel.h"
+#include "shapes.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of elements (or vertices) handled by one parallel chunk
+constexpr std::size_t grain = 4096;
+
+template <ElementType Type, std::size_t N>
+auto cell_geometry(const std::array<Point, N> &corners, Point &centroid,
+                   Point *face_area_vectors) -> double {
+  /**
+   * @brief Volume, centroid and outward face area vectors of a cell, as the
+   * sum of the pyramids joining its vertices average to each face.
+   */
+  auto apex = average(corners);
+
+  double volume = 0.;
+  Point weighted{0., 0., 0.};
+  for (const auto &local : cell_faces<Type>()) {
+    const auto &c = local.corners;
+    auto face = local.n_corners == 3
+                    ? triangle_geometry(corners[c[0]], corners[c[1]],
+                                        corners[c[2]])
+                    : quad_geometry(corners[c[0]], corners[c[1]],
+                                    corners[c[2]], corners[c[3]]);
+
+    // faces of a cell with negative volume point inward, flip them
+    auto height = subtract(face.centroid, apex);
+    auto signed_pyramid = dot(face.area_vector, height) / 3.;
+    if (signed_pyramid < 0.) {
+      for (auto &x : face.area_vector) {
+        x = -x;
+      }
+    }
+    *face_area_vectors++ = face.area_vector;
+
+    // pyramid centroid lies at 3/4 of the way from apex to base centroid
+    auto pyramid = std::abs(signed_pyramid);
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      weighted[axis] += pyramid * (apex[axis] + 0.75 * height[axis]);
+    }
+    volume += pyramid;
+  }
+
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    centroid[axis] = volume > 0. ? weighted[axis] / volume : apex[axis];
+  }
+  return volume;
+}
+
+template <ElementType Type>
+auto block_geometry(const ElementBlock<Type> &block, std::size_t begin,
+                    std::size_t end, const std::vector<Point> &vertices,
+                    Geometry &geometry) -> double {
+  /**
+   * @brief Compute the geometry of the elements [begin, end) of a block.
+   *
+   * @return double Total volume of these elements if they are cells, zero
+   * otherwise.
+   */
+  constexpr auto n_corners = ElementBlock<Type>::n_vertices;
+  std::array<Point, n_corners> corners;
+
+  double volume = 0.;
+  for (auto i = begin; i < end; ++i) {
+    for (std::size_t c = 0; c < n_corners; ++c) {
+      corners[c] = vertices[block.vertices_ids[i][c]];
+    }
+
+    auto e_id = block.elements_ids[i];
+    auto &centroid = geometry.centroids[e_id];
+
+    if constexpr (Type == ElementType::Line) {
+      centroid = average(corners);
+      geometry.measures[e_id] = norm(subtract(corners[1], corners[0]));
+    } else if constexpr (Type == ElementType::Triangle ||
+                         Type == ElementType::Quad) {
+      auto face = Type == ElementType::Triangle
+                      ? triangle_geometry(corners[0], corners[1], corners[2])
+                      : quad_geometry(corners[0], corners[1], corners[2],
+                                      corners[n_corners - 1]);
+      centroid = face.centroid;
+      geometry.area_vectors[e_id] = face.area_vector;
+      geometry.measures[e_id] = norm(face.area_vector);
+    } else {
+      auto cell_volume = cell_geometry<Type>(
+          corners, centroid,
+          geometry.face_area_vectors.data() + geometry.faces_offsets[e_id]);
+      geometry.measures[e_id] = cell_volume;
+      volume += cell_volume;
+    }
+  }
+  return volume;
+}
+
+auto faces_count(ElementType type) -> std::size_t {
+  switch (type) {
+  case ElementType::Tetra:
+    return cell_faces<ElementType::Tetra>().size();
+  case ElementType::Wedge:
+    return cell_faces<ElementType::Wedge>().size();
+  case ElementType::Hex:
+    return cell_faces<ElementType::Hex>().size();
+  default:
+    return 0;
+  }
+}
+
+/* Range of the vertices, or of an element block, handled by one task */
+struct Task {
+  std::optional<ElementType> type;
+  std::size_t begin;
+  std::size_t end;
+};
+
+auto task_geometry(const Task &task, const ElementBlocks &blocks,
+                   const std::vector<Point> &vertices, Geometry &geometry)
+    -> double {
+  switch (task.type.value()) {
+  case ElementType::Line:
+    return block_geometry(blocks.lines, task.begin, task.end, vertices,
+                          geometry);
+  case ElementType::Triangle:
+    return block_geometry(blocks.triangles, task.begin, task.end, vertices,
+                          geometry);
+  case ElementType::Quad:
+    return block_geometry(blocks.quads, task.begin, task.end, vertices,
+                          geometry);
+  case ElementType::Tetra:
+    return block_geometry(blocks.tetras, task.begin, task.end, vertices,
+                          geometry);
+  case ElementType::Wedge:
+    return block_geometry(blocks.wedges, task.begin, task.end, vertices,
+                          geometry);
+  case ElementType::Hex:
+    return block_geometry(blocks.hexes, task.begin, task.end, vertices,
+                          geometry);
+  }
+  return 0.;
+}
+
+auto empty_box() -> BoundingBox {
+  constexpr auto infinity = std::numeric_limits<double>::infinity();
+  return BoundingBox{{infinity, infinity, infinity},
+                     {-infinity, -infinity, -infinity}};
+}
+
+void extend(BoundingBox &box, const Point &lower, const Point &upper) {
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    box.lower[axis] = std::min(box.lower[axis], lower[axis]);
+    box.upper[axis] = std::max(box.upper[axis], upper[axis]);
+  }
+}
+
+} // namespace
+
+auto compute_geometry(const Mesh &mesh) -> Geometry {
+  /**
+   * @brief Compute element centroids, volumes, areas and area vectors, cell
+   * face area vectors, the mesh bounding box and its total volume.
+   *
+   * Vertices and each element block are split into chunks, all of them run
+   * as the tasks of a single parallel loop: vertex tasks extend their own
+   * bounding box, block tasks run the kernel of their element type and sum
+   * their volumes. Task results are then reduced in task order.
+   *
+   * @param mesh the mesh
+   * @return Geometry
+   */
+  const auto &vertices = mesh.vertices();
+  auto n_elements = mesh.elements().has_value() ? mesh.elements()->size() : 0;
+
+  Geometry geometry;
+  geometry.centroids.assign(n_elements, Point{0., 0., 0.});
+  geometry.measures.assign(n_elements, 0.);
+  geometry.area_vectors.assign(n_elements, Point{0., 0., 0.});
+  geometry.faces_offsets.assign(n_elements + 1, 0);
+  for (std::size_t e_id = 0; e_id < n_elements; ++e_id) {
+    geometry.faces_offsets[e_id + 1] =
+        geometry.faces_offsets[e_id] +
+        faces_count(mesh.elements().value()[e_id].type());
+  }
+  geometry.face_area_vectors.assign(geometry.faces_offsets.back(),
+                                    Point{0., 0., 0.});
+
+  auto blocks = mesh.element_blocks();
+  std::vector<Task> tasks;
+  auto add_tasks = [&](std::optional<ElementType> type, std::size_t n) {
+    for (std::size_t begin = 0; begin < n; begin += grain) {
+      tasks.push_back({type, begin, std::min(n, begin + grain)});
+    }
+  };
+  add_tasks(std::nullopt, vertices.size());
+  add_tasks(ElementType::Line, blocks.lines.elements_ids.size());
+  add_tasks(ElementType::Triangle, blocks.triangles.elements_ids.size());
+  add_tasks(ElementType::Quad, blocks.quads.elements_ids.size());
+  add_tasks(ElementType::Tetra, blocks.tetras.elements_ids.size());
+  add_tasks(ElementType::Wedge, blocks.wedges.elements_ids.size());
+  add_tasks(ElementType::Hex, blocks.hexes.elements_ids.size());
+
+  std::vector<BoundingBox> boxes(tasks.size(), empty_box());
+  std::vector<double> volumes(tasks.size(), 0.);
+  parallel_for(tasks.size(), 1, [&](std::size_t begin, std::size_t end) {
+    for (auto t = begin; t < end; ++t) {
+      const auto &task = tasks[t];
+      if (task.type.has_value()) {
+        volumes[t] = task_geometry(task, blocks, vertices, geometry);
+        continue;
+      }
+      for (auto v_id = task.begin; v_id < task.end; ++v_id) {
+        extend(boxes[t], vertices[v_id], vertices[v_id]);
+      }
+    }
+  });
+
+  geometry.bounding_box = empty_box();
+  for (const auto &box : boxes) {
+    extend(geometry.bounding_box, box.lower, box.upper);
+  }
+  geometry.total_volume = std::accumulate(volumes.begin(), volumes.end(), 0.);
+
+  return geometry;
+}
+
+} // namespace unvpp
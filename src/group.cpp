@@ -1,8 +1,129 @@
 #include "unvpp/unvpp.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace unvpp {
-Group::Group(std::string name, GroupType type,
-             std::vector<std::size_t> elements_ids)
+
+GroupMembers::GroupMembers(const std::vector<std::size_t> &ids) {
+  for (auto id : ids) {
+    push_back(id);
+  }
+}
+
+void GroupMembers::push_back(std::size_t id) {
+  /**
+   * @brief Append an id, extending the last range when the id follows it.
+   *
+   * @param id id to append
+   */
+  if (!_ranges.empty()) {
+    auto &last = _ranges.back();
+    auto last_end = last.first + last.count;
+
+    if (id == last_end) {
+      ++last.count;
+      ++_size;
+      return;
+    }
+
+    if (id < last_end) {
+      _sorted = false;
+    }
+  }
+
+  _ranges.push_back(Range{id, 1});
+  _offsets.push_back(_size);
+  ++_size;
+}
+
+void GroupMembers::clear() noexcept {
+  _ranges.clear();
+  _offsets.clear();
+  _size = 0;
+  _sorted = true;
+}
+
+auto GroupMembers::size() const noexcept -> std::size_t { return _size; }
+
+auto GroupMembers::empty() const noexcept -> bool { return _size == 0; }
+
+auto GroupMembers::operator[](std::size_t i) const -> std::size_t {
+  /**
+   * @brief Get the i-th member.
+   *
+   * @param i position of the member, in [0, size())
+   * @return std::size_t
+   * @throw std::runtime_error If i is out of range.
+   */
+  if (i >= _size) {
+    throw std::runtime_error("unvpp::GroupMembers::operator[](): Position " +
+                             std::to_string(i) + " is out of range");
+  }
+
+  auto iter = std::upper_bound(_offsets.begin(), _offsets.end(), i);
+  auto range = static_cast<std::size_t>(iter - _offsets.begin()) - 1;
+  return _ranges[range].first + (i - _offsets[range]);
+}
+
+auto GroupMembers::contains(std::size_t id) const -> bool {
+  /**
+   * @brief Check if an id is a member. The ranges are bisected when they are
+   * increasing, and scanned otherwise.
+   *
+   * @param id id to look for
+   * @return true if id is a member
+   */
+  auto in_range = [id](const Range &range) {
+    return id >= range.first && id - range.first < range.count;
+  };
+
+  if (!_sorted) {
+    return std::any_of(_ranges.begin(), _ranges.end(), in_range);
+  }
+
+  auto iter = std::upper_bound(
+      _ranges.begin(), _ranges.end(), id,
+      [](std::size_t value, const Range &range) { return value < range.first; });
+  return iter != _ranges.begin() && in_range(*std::prev(iter));
+}
+
+auto GroupMembers::ranges() const noexcept -> const std::vector<Range> & {
+  return _ranges;
+}
+
+auto GroupMembers::capacity() const noexcept -> std::size_t {
+  /**
+   * @brief Number of ranges storage is allocated for, ranges and their
+   * offsets growing together.
+   */
+  return _ranges.capacity();
+}
+
+auto GroupMembers::to_vector() const -> std::vector<std::size_t> {
+  return std::vector<std::size_t>(begin(), end());
+}
+
+auto GroupMembers::begin() const noexcept -> Iterator {
+  return Iterator(_ranges.data(), 0);
+}
+
+auto GroupMembers::end() const noexcept -> Iterator {
+  return Iterator(_ranges.data() + _ranges.size(), 0);
+}
+
+auto GroupMembers::operator==(const GroupMembers &other) const noexcept
+    -> bool {
+  // ranges are maximal runs, so equal lists have equal ranges
+  return _ranges == other._ranges;
+}
+
+auto GroupMembers::operator!=(const GroupMembers &other) const noexcept
+    -> bool {
+  return !(*this == other);
+}
+
+Group::Group(std::string name, GroupType type, GroupMembers elements_ids)
     : _name(std::move(name)), _type(type),
       _elements_ids(std::move(elements_ids)) {}
 
@@ -10,16 +131,15 @@ auto Group::name() const noexcept -> const std::string & { return _name; }
 
 auto Group::type() const noexcept -> GroupType { return _type; }
 
-auto Group::elements_ids() -> std::vector<std::size_t> & {
+auto Group::elements_ids() const noexcept -> const GroupMembers & {
   return _elements_ids;
 }
 
-auto Group::elements_ids() const -> const std::vector<std::size_t> & {
-  return _elements_ids;
+void Group::set_elements_ids(GroupMembers elements_ids) {
+  _elements_ids = std::move(elements_ids);
 }
 
-auto Group::unique_element_types() const
-    -> const std::unordered_set<ElementType> & {
+auto Group::unique_element_types() const noexcept -> ElementTypes {
   return _unique_element_types;
 }
 
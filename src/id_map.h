@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+
+namespace unvpp {
+
+/* Map from UNV ids to the order in which records were read */
+class IdMap {
+  /**
+   * @brief UNV files usually number their records consecutively, so the map
+   * is kept as a range of ids (no memory per record) while ids inserted in
+   * reading order are consecutive, and turns into a hash map otherwise.
+   */
+public:
+  void reserve(std::size_t n) {
+    _reserved = n;
+    if (!_dense) {
+      _map.reserve(n);
+    }
+  }
+
+  auto insert(std::size_t unv_id, std::size_t id) -> bool {
+    /**
+     * @brief Map a UNV id, replacing any previous mapping of that id.
+     *
+     * @return false if the id was already mapped
+     */
+    if (_dense) {
+      if (_count == 0 && id == 0) {
+        _first = unv_id;
+        _count = 1;
+        return true;
+      }
+      if (unv_id == _first + _count && id == _count) {
+        ++_count;
+        return true;
+      }
+      to_sparse();
+    }
+
+    auto [iter, inserted] = _map.emplace(unv_id, id);
+    if (!inserted) {
+      iter->second = id;
+    }
+    return inserted;
+  }
+
+  auto find(std::size_t unv_id) const -> std::optional<std::size_t> {
+    if (_dense) {
+      if (unv_id >= _first && unv_id - _first < _count) {
+        return unv_id - _first;
+      }
+      return std::nullopt;
+    }
+
+    auto iter = _map.find(unv_id);
+    if (iter == _map.end()) {
+      return std::nullopt;
+    }
+    return iter->second;
+  }
+
+private:
+  void to_sparse() {
+    _map.reserve(_reserved > _count ? _reserved : _count);
+    for (std::size_t id = 0; id < _count; ++id) {
+      _map.emplace(_first + id, id);
+    }
+    _dense = false;
+  }
+
+  bool _dense{true};
+  std::size_t _first{0};
+  std::size_t _count{0};
+  std::size_t _reserved{0};
+  std::unordered_map<std::size_t, std::size_t> _map;
+};
+
+} // namespace unvpp
@@ -0,0 +1,162 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <mutex>
+
+#include "dataset_index.h"
+#include "reader.h"
+
+namespace unvpp {
+
+namespace {
+
+void read_datasets(Reader &reader,
+                   const std::vector<DatasetPosition> &positions,
+                   std::initializer_list<TagKind> kinds) {
+  for (const auto &dataset : positions) {
+    if (std::find(kinds.begin(), kinds.end(), dataset.kind) != kinds.end()) {
+      reader.seek(dataset.position, dataset.line_number);
+      reader.read_tag(dataset.kind);
+    }
+  }
+}
+
+} // namespace
+
+struct LazyMesh::State {
+  explicit State(const std::filesystem::path &path)
+      : path(path), reader(path) {}
+
+  void read_datasets(const std::vector<DatasetPosition> &positions,
+                     std::initializer_list<TagKind> kinds) {
+    // the reader stream is shared by vertices and elements
+    std::lock_guard<std::mutex> lock(reader_mutex);
+    unvpp::read_datasets(reader, positions, kinds);
+  }
+
+  auto datasets() -> const std::vector<DatasetPosition> & {
+    std::call_once(index_once, [this]() { index = index_datasets(path); });
+    return index;
+  }
+
+  std::filesystem::path path;
+
+  std::once_flag index_once;
+  std::once_flag units_once;
+  std::once_flag vertices_once;
+  std::once_flag elements_once;
+  std::once_flag groups_once;
+
+  std::vector<DatasetPosition> index;
+
+  std::mutex reader_mutex;
+  Reader reader;
+
+  std::optional<UnitsSystem> unit_system;
+  std::vector<std::array<double, 3>> vertices;
+  std::optional<std::vector<Element>> elements;
+  std::optional<std::vector<Group>> groups;
+};
+
+LazyMesh::LazyMesh(const std::filesystem::path &path) {
+  check_input_file(path);
+  _state = std::make_shared<State>(path);
+}
+
+auto LazyMesh::unit_system() const -> const std::optional<UnitsSystem> & {
+  /**
+   * @brief Get the units system, reading the first units tag of the file.
+   *
+   * @return The units system.
+   */
+  auto &state = *_state;
+  std::call_once(state.units_once, [&state]() {
+    // only scan the file up to the units tag, which usually comes first
+    state.read_datasets(index_datasets(state.path, TagKind::Units),
+                        {TagKind::Units});
+    state.unit_system = state.reader.units();
+  });
+  return state.unit_system;
+}
+
+auto LazyMesh::vertices() const -> const std::vector<std::array<double, 3>> & {
+  /**
+   * @brief Get the vertices, reading the vertices tags of the file.
+   *
+   * @return The vertices array.
+   */
+  auto &state = *_state;
+  std::call_once(state.vertices_once, [&state]() {
+    state.read_datasets(state.datasets(), {TagKind::Vertices});
+    state.vertices = std::move(state.reader.vertices());
+  });
+  return state.vertices;
+}
+
+auto LazyMesh::elements() const -> const std::optional<std::vector<Element>> & {
+  /**
+   * @brief Get the elements, reading the vertices and elements tags of the
+   * file.
+   *
+   * @return The elements array.
+   */
+  auto &state = *_state;
+
+  // elements vertices ids are resolved against the vertices tags
+  vertices();
+
+  std::call_once(state.elements_once, [&state]() {
+    state.read_datasets(state.datasets(), {TagKind::Elements});
+    state.elements = std::move(state.reader.elements());
+  });
+  return state.elements;
+}
+
+auto LazyMesh::groups() const -> const std::optional<std::vector<Group>> & {
+  /**
+   * @brief Get the groups, reading the groups tags of the file.
+   *
+   * Members are resolved against an index of the vertices and elements ids
+   * and elements types, built by a separate reader that skips vertices
+   * coordinates and elements connectivity, and dropped once groups are read.
+   *
+   * @return The groups array.
+   */
+  auto &state = *_state;
+  std::call_once(state.groups_once, [&state]() {
+    auto reader = Reader(state.path);
+    reader.set_ids_only(true);
+    read_datasets(reader, state.datasets(),
+                  {TagKind::Vertices, TagKind::Elements, TagKind::Group,
+                   TagKind::DOFs});
+    state.groups = std::move(reader.groups());
+  });
+  return state.groups;
+}
+
+} // namespace unvpp
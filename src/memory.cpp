@@ -0,0 +1,116 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/unvpp.h>
+
+#include <array>
+#include <vector>
+
+namespace unvpp {
+
+namespace {
+
+template <typename T>
+auto unused_bytes(const std::vector<T> &values) noexcept -> std::size_t {
+  return (values.capacity() - values.size()) * sizeof(T);
+}
+
+} // namespace
+
+auto Mesh::memory_usage() const noexcept -> MemoryUsage {
+  /**
+   * @brief Bytes held by the mesh, split by component.
+   *
+   * Data bytes are the sizes of the stored values. Everything else the mesh
+   * arrays hold counts as overhead: the Mesh, Element and Group objects
+   * themselves (each element owning a separate ids array) and the capacity
+   * left unused after loading or editing the mesh, see compact(). Allocator
+   * bookkeeping and short group names stored inline are not counted.
+   *
+   * @return MemoryUsage
+   */
+  MemoryUsage usage;
+  usage.overhead = sizeof(Mesh);
+
+  usage.vertices = _vertices.size() * sizeof(std::array<double, 3>);
+  usage.overhead += unused_bytes(_vertices);
+
+  if (_elements.has_value()) {
+    const auto &elements = _elements.value();
+    for (const auto &element : elements) {
+      const auto &ids = element.vertices_ids();
+      usage.connectivity += ids.size() * sizeof(std::size_t);
+      usage.overhead += unused_bytes(ids);
+    }
+    usage.connectivity += elements.size() * sizeof(ElementType);
+    usage.overhead += elements.capacity() * sizeof(Element) -
+                      elements.size() * sizeof(ElementType);
+  }
+
+  if (_groups.has_value()) {
+    const auto &groups = _groups.value();
+    constexpr auto range_bytes =
+        sizeof(GroupMembers::Range) + sizeof(std::size_t);
+    for (const auto &group : groups) {
+      const auto &members = group.elements_ids();
+      usage.groups += group.name().size();
+      usage.groups += members.ranges().size() * range_bytes;
+      usage.overhead +=
+          (members.capacity() - members.ranges().size()) * range_bytes;
+    }
+    usage.overhead += groups.capacity() * sizeof(Group);
+  }
+
+  return usage;
+}
+
+void Mesh::compact() {
+  /**
+   * @brief Release the capacity left unused by the mesh arrays.
+   *
+   * Arrays with spare capacity are reallocated to their exact size, so that
+   * memory_usage().overhead is reduced to the objects headers. Values, ids
+   * and order are unchanged, but references into the mesh are invalidated.
+   * For a single contiguous connectivity array, see read_compact().
+   */
+  _vertices.shrink_to_fit();
+
+  if (_elements.has_value()) {
+    auto &elements = _elements.value();
+    elements.shrink_to_fit();
+    for (auto &element : elements) {
+      element.vertices_ids().shrink_to_fit();
+    }
+  }
+
+  if (_groups.has_value()) {
+    auto &groups = _groups.value();
+    groups.shrink_to_fit();
+    for (auto &group : groups) {
+      // copies of the members are allocated to their exact size
+      group.set_elements_ids(group.elements_ids());
+    }
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,315 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "parallel.h"
+
+namespace unvpp {
+
+namespace {
+
+using Cell = std::array<std::int64_t, 3>;
+
+// number of vertices handled by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+// number of hash grid partitions, built independently in parallel
+constexpr std::size_t n_partitions = 256;
+
+constexpr auto no_vertex = std::numeric_limits<std::size_t>::max();
+
+struct CellHash {
+  auto operator()(const Cell &cell) const noexcept -> std::size_t {
+    // 64-bit mix of the three cell coordinates (splitmix64 finalizer)
+    auto h = static_cast<std::uint64_t>(cell[0]) * 0x9E3779B97F4A7C15ULL ^
+             static_cast<std::uint64_t>(cell[1]) * 0xC2B2AE3D27D4EB4FULL ^
+             static_cast<std::uint64_t>(cell[2]) * 0x165667B19E3779F9ULL;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return static_cast<std::size_t>(h);
+  }
+};
+
+auto find_root(std::vector<std::size_t> &parent, std::size_t v_id)
+    -> std::size_t {
+  auto root = v_id;
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+  while (parent[v_id] != root) {
+    auto next = parent[v_id];
+    parent[v_id] = root;
+    v_id = next;
+  }
+  return root;
+}
+
+} // namespace
+
+auto Mesh::merge_vertices(double tolerance) -> std::vector<std::size_t> {
+  /**
+   * @brief Merge vertices closer than a tolerance.
+   *
+   * Vertices are hashed into a uniform grid of cell size `tolerance`, so only
+   * the 27 neighbouring cells of each vertex are searched, giving O(n)
+   * expected time. Grid partitions are built and searched in parallel.
+   * Merging is transitive: vertices connected by a chain of close pairs
+   * collapse to the one with the lowest index, whose coordinates are kept.
+   * Remaining vertices keep their relative order, elements connectivity is
+   * updated (elements themselves are kept, even if they degenerate) and
+   * duplicates are removed from vertex groups.
+   *
+   * @param tolerance maximum distance between merged vertices, zero merges
+   * coincident vertices only.
+   * @return std::vector<std::size_t> The new index of each previous vertex.
+   * @throw std::runtime_error If tolerance is negative or not finite, or too
+   * small for the extent of the mesh to fit in the grid.
+   */
+  if (!(tolerance >= 0.) || !std::isfinite(tolerance)) {
+    throw std::runtime_error(
+        "unvpp::Mesh::merge_vertices(): Invalid tolerance " +
+        std::to_string(tolerance));
+  }
+
+  auto n_vertices = _vertices.size();
+  auto cell_size = tolerance > 0. ? tolerance : 1.;
+  auto squared_tolerance = tolerance * tolerance;
+
+  std::array<double, 3> lower{};
+  std::array<double, 3> upper{};
+  if (n_vertices > 0) {
+    lower = _vertices.front();
+    upper = _vertices.front();
+  }
+  for (const auto &vertex : _vertices) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      lower[axis] = std::min(lower[axis], vertex[axis]);
+      upper[axis] = std::max(upper[axis], vertex[axis]);
+    }
+  }
+
+  // grid cells, and their neighbours, must fit in 64-bit integers
+  constexpr auto max_cells = static_cast<double>(std::int64_t{1} << 62);
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    if (!((upper[axis] - lower[axis]) / cell_size < max_cells)) {
+      throw std::runtime_error(
+          "unvpp::Mesh::merge_vertices(): Tolerance " +
+          std::to_string(tolerance) + " is too small for the mesh extent");
+    }
+  }
+
+  auto cell_of = [&](const std::array<double, 3> &vertex) {
+    Cell cell{};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      cell[axis] =
+          static_cast<std::int64_t>((vertex[axis] - lower[axis]) / cell_size);
+    }
+    return cell;
+  };
+  auto partition_of = [](const Cell &cell) {
+    return (CellHash()(cell) >> 32) % n_partitions;
+  };
+
+  // counting sort of the vertices by grid partition
+  auto n_chunks = chunks_count(n_vertices, grain);
+  std::vector<std::size_t> histogram(n_chunks * n_partitions, 0);
+
+  parallel_for_chunks(
+      n_vertices, grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        for (auto v_id = begin; v_id < end; ++v_id) {
+          ++histogram[chunk * n_partitions +
+                      partition_of(cell_of(_vertices[v_id]))];
+        }
+      });
+
+  std::vector<std::size_t> partition_offsets(n_partitions + 1, 0);
+  std::vector<std::size_t> chunk_offsets(n_chunks * n_partitions, 0);
+  std::size_t offset = 0;
+  for (std::size_t p = 0; p < n_partitions; ++p) {
+    partition_offsets[p] = offset;
+    for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      chunk_offsets[chunk * n_partitions + p] = offset;
+      offset += histogram[chunk * n_partitions + p];
+    }
+  }
+  partition_offsets[n_partitions] = offset;
+
+  std::vector<std::size_t> sorted(n_vertices);
+  parallel_for_chunks(
+      n_vertices, grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto *cursor = &chunk_offsets[chunk * n_partitions];
+        for (auto v_id = begin; v_id < end; ++v_id) {
+          sorted[cursor[partition_of(cell_of(_vertices[v_id]))]++] = v_id;
+        }
+      });
+
+  // each partition maps its grid cells to a linked list of vertices
+  std::vector<std::unordered_map<Cell, std::size_t, CellHash>> grid(
+      n_partitions);
+  std::vector<std::size_t> next(n_vertices, no_vertex);
+
+  parallel_for(n_partitions, 1, [&](std::size_t begin, std::size_t end) {
+    for (auto p = begin; p < end; ++p) {
+      auto &cells = grid[p];
+      cells.reserve(partition_offsets[p + 1] - partition_offsets[p]);
+      for (auto i = partition_offsets[p + 1]; i-- > partition_offsets[p];) {
+        auto v_id = sorted[i];
+        auto [iter, inserted] = cells.try_emplace(cell_of(_vertices[v_id]), v_id);
+        if (!inserted) {
+          next[v_id] = iter->second;
+          iter->second = v_id;
+        }
+      }
+    }
+  });
+  sorted = {};
+
+  // pairs of close vertices, found in parallel and merged in chunk order
+  std::vector<std::vector<std::pair<std::size_t, std::size_t>>> chunks_pairs(
+      n_chunks);
+
+  parallel_for_chunks(
+      n_vertices, grain,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &pairs = chunks_pairs[chunk];
+        for (auto v_id = begin; v_id < end; ++v_id) {
+          const auto &vertex = _vertices[v_id];
+          auto center = cell_of(vertex);
+
+          for (std::int64_t dx = -1; dx <= 1; ++dx) {
+            for (std::int64_t dy = -1; dy <= 1; ++dy) {
+              for (std::int64_t dz = -1; dz <= 1; ++dz) {
+                Cell cell{center[0] + dx, center[1] + dy, center[2] + dz};
+                const auto &cells = grid[partition_of(cell)];
+                auto iter = cells.find(cell);
+                if (iter == cells.end()) {
+                  continue;
+                }
+
+                for (auto u_id = iter->second; u_id != no_vertex;
+                     u_id = next[u_id]) {
+                  if (u_id <= v_id) {
+                    continue;
+                  }
+                  const auto &other = _vertices[u_id];
+                  auto distance = (vertex[0] - other[0]) * (vertex[0] - other[0]) +
+                                  (vertex[1] - other[1]) * (vertex[1] - other[1]) +
+                                  (vertex[2] - other[2]) * (vertex[2] - other[2]);
+                  if (distance <= squared_tolerance) {
+                    pairs.emplace_back(v_id, u_id);
+                  }
+                }
+              }
+            }
+          }
+        }
+      });
+  grid = {};
+  next = {};
+
+  std::vector<std::size_t> parent(n_vertices);
+  std::iota(parent.begin(), parent.end(), 0);
+
+  for (const auto &pairs : chunks_pairs) {
+    for (auto [v_id, u_id] : pairs) {
+      auto v_root = find_root(parent, v_id);
+      auto u_root = find_root(parent, u_id);
+      if (v_root < u_root) {
+        parent[u_root] = v_root;
+      } else if (u_root < v_root) {
+        parent[v_root] = u_root;
+      }
+    }
+  }
+  chunks_pairs = {};
+
+  // roots are the lowest index of their cluster, so they are numbered
+  // before any of the vertices merged into them
+  std::vector<std::size_t> new_ids(n_vertices);
+  std::size_t n_kept = 0;
+  for (std::size_t v_id = 0; v_id < n_vertices; ++v_id) {
+    auto root = find_root(parent, v_id);
+    if (root == v_id) {
+      _vertices[n_kept] = _vertices[v_id];
+      new_ids[v_id] = n_kept++;
+    } else {
+      new_ids[v_id] = new_ids[root];
+    }
+  }
+  _vertices.resize(n_kept);
+  _vertices.shrink_to_fit();
+
+  if (n_kept == n_vertices) {
+    return new_ids;
+  }
+
+  if (_elements.has_value()) {
+    auto &elements = *_elements;
+    parallel_for(elements.size(), grain,
+                 [&](std::size_t begin, std::size_t end) {
+                   for (auto e_id = begin; e_id < end; ++e_id) {
+                     for (auto &v_id : elements[e_id].vertices_ids()) {
+                       v_id = new_ids[v_id];
+                     }
+                   }
+                 });
+  }
+
+  if (_groups.has_value()) {
+    for (auto &group : *_groups) {
+      if (group.type() != GroupType::Vertex) {
+        continue;
+      }
+
+      std::unordered_set<std::size_t> seen;
+      seen.reserve(group.elements_ids().size());
+
+      GroupMembers ids;
+      for (auto v_id : group.elements_ids()) {
+        if (seen.insert(new_ids[v_id]).second) {
+          ids.push_back(new_ids[v_id]);
+        }
+      }
+      group.set_elements_ids(std::move(ids));
+    }
+  }
+
+  return new_ids;
+}
+
+} // namespace unvpp
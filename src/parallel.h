@@ -0,0 +1,158 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+
+#include <unvpp/executor.h>
+
+namespace unvpp {
+
+inline auto chunks_count(std::size_t n, std::size_t grain) noexcept
+    -> std::size_t {
+  /**
+   * @brief Number of chunks of size `grain` needed to cover [0, n).
+   */
+  grain = std::max<std::size_t>(grain, 1);
+  return (n + grain - 1) / grain;
+}
+
+template <typename Fn>
+void parallel_for_chunks(std::size_t n, std::size_t grain, Fn &&fn) {
+  /**
+   * @brief Run `fn(chunk, begin, end)` over [0, n) split into chunks of
+   * `grain` items.
+   *
+   * Chunk boundaries depend only on `n` and `grain`, never on the number of
+   * threads, so per-chunk partial results combined in chunk order give the
+   * same answer on any machine and any executor. Chunks run on
+   * current_executor(), the first exception thrown by `fn` is rethrown on
+   * the calling thread once all chunks have stopped.
+   *
+   * @param n Number of items.
+   * @param grain Number of items per chunk.
+   * @param fn Callable invoked as fn(chunk_index, begin, end).
+   */
+  grain = std::max<std::size_t>(grain, 1);
+  auto n_chunks = chunks_count(n, grain);
+
+  auto run_chunk = [&](std::size_t chunk) {
+    auto begin = chunk * grain;
+    auto end = std::min(n, begin + grain);
+    fn(chunk, begin, end);
+  };
+
+  if (n_chunks <= 1) {
+    for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      run_chunk(chunk);
+    }
+    return;
+  }
+
+  auto &executor = current_executor();
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  executor.parallel_for(n_chunks, [&](std::size_t chunk) {
+    // stop running chunks once one has failed
+    if (failed.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // loops nested in a chunk run on the same executor, whatever thread
+    // runs the chunk
+    ExecutorScope scope(executor);
+    try {
+      run_chunk(chunk);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      failed.store(true, std::memory_order_relaxed);
+    }
+  });
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename Fn>
+void parallel_for(std::size_t n, std::size_t grain, Fn &&fn) {
+  /**
+   * @brief Run `fn(begin, end)` over [0, n) split into chunks of `grain`
+   * items, see parallel_for_chunks().
+   */
+  parallel_for_chunks(n, grain,
+                      [&](std::size_t /*chunk*/, std::size_t begin,
+                          std::size_t end) { fn(begin, end); });
+}
+
+template <typename Iterator, typename Compare>
+void parallel_sort(Iterator first, Iterator last, Compare comp) {
+  /**
+   * @brief Sort a random access range in parallel.
+   *
+   * Fixed size runs are sorted concurrently, then merged pairwise level by
+   * level. Like std::sort the sort is not stable, but the result depends only
+   * on the input, never on the number of threads.
+   *
+   * @param first beginning of the range
+   * @param last end of the range
+   * @param comp strict weak ordering of the range values
+   */
+  constexpr std::size_t run_size = std::size_t{1} << 16;
+  auto n = static_cast<std::size_t>(std::distance(first, last));
+
+  if (n <= run_size) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  parallel_for(n, run_size, [&](std::size_t begin, std::size_t end) {
+    std::sort(first + begin, first + end, comp);
+  });
+
+  for (auto width = run_size; width < n; width *= 2) {
+    parallel_for(chunks_count(n, 2 * width), 1,
+                 [&](std::size_t begin, std::size_t end) {
+                   for (auto pair = begin; pair < end; ++pair) {
+                     auto low = pair * 2 * width;
+                     auto middle = std::min(low + width, n);
+                     auto high = std::min(low + 2 * width, n);
+                     std::inplace_merge(first + low, first + middle,
+                                        first + high, comp);
+                   }
+                 });
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,522 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/partition.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "common.h"
+#include "parallel.h"
+#include "topology.h"
+
+namespace unvpp {
+
+namespace {
+
+using Point = std::array<double, 3>;
+
+// number of items handled by one parallel chunk
+constexpr std::size_t grain = 4096;
+
+// allowed part size excess over the average, during refinement
+constexpr double imbalance = 0.03;
+
+// maximum number of greedy refinement passes
+constexpr std::size_t max_refinement_passes = 8;
+
+constexpr auto no_part = std::numeric_limits<std::size_t>::max();
+
+auto cells_centroids(const Mesh &mesh, const std::vector<std::size_t> &cells)
+    -> std::vector<Point> {
+  const auto &vertices = mesh.vertices();
+  const auto &elements = mesh.elements().value();
+
+  std::vector<Point> centroids(cells.size());
+  parallel_for(cells.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      const auto &ids = elements[cells[i]].vertices_ids();
+      Point centroid{0., 0., 0.};
+      for (auto v_id : ids) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          centroid[axis] += vertices[v_id][axis];
+        }
+      }
+      for (auto &x : centroid) {
+        x /= static_cast<double>(std::max<std::size_t>(ids.size(), 1));
+      }
+      centroids[i] = centroid;
+    }
+  });
+  return centroids;
+}
+
+auto coordinate_bisection(const std::vector<Point> &centroids,
+                          std::size_t n_parts) -> std::vector<std::size_t> {
+  /**
+   * @brief Recursive coordinate bisection. Each range of cells assigned to k
+   * parts is split along the widest axis of its centroids, in proportion
+   * k / 2 to k - k / 2. Ranges of a recursion level are split in parallel.
+   */
+  struct Range {
+    std::size_t first;
+    std::size_t count;
+    std::size_t first_part;
+    std::size_t n_parts;
+  };
+
+  std::vector<std::size_t> order(centroids.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  std::vector<std::size_t> parts(centroids.size(), 0);
+  std::vector<Range> level{{0, centroids.size(), 0, n_parts}};
+
+  while (!level.empty()) {
+    std::vector<Range> next_level(2 * level.size());
+
+    parallel_for(level.size(), 1, [&](std::size_t begin, std::size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        auto range = level[i];
+        auto first = order.begin() + range.first;
+        auto last = first + range.count;
+
+        if (range.n_parts == 1 || range.count == 0) {
+          for (auto cell = first; cell != last; ++cell) {
+            parts[*cell] = range.first_part;
+          }
+          continue;
+        }
+
+        Point lower = centroids[*first];
+        Point upper = lower;
+        for (auto cell = first; cell != last; ++cell) {
+          for (std::size_t axis = 0; axis < 3; ++axis) {
+            lower[axis] = std::min(lower[axis], centroids[*cell][axis]);
+            upper[axis] = std::max(upper[axis], centroids[*cell][axis]);
+          }
+        }
+
+        std::size_t axis = 0;
+        for (std::size_t a = 1; a < 3; ++a) {
+          if (upper[a] - lower[a] > upper[axis] - lower[axis]) {
+            axis = a;
+          }
+        }
+
+        auto left_parts = range.n_parts / 2;
+        auto left_count = range.count * left_parts / range.n_parts;
+
+        std::nth_element(first, first + left_count, last,
+                         [&](std::size_t lhs, std::size_t rhs) {
+                           auto c_lhs = centroids[lhs][axis];
+                           auto c_rhs = centroids[rhs][axis];
+                           return c_lhs < c_rhs || (c_lhs == c_rhs && lhs < rhs);
+                         });
+
+        next_level[2 * i] = {range.first, left_count, range.first_part,
+                             left_parts};
+        next_level[2 * i + 1] = {range.first + left_count,
+                                 range.count - left_count,
+                                 range.first_part + left_parts,
+                                 range.n_parts - left_parts};
+      }
+    });
+
+    level.clear();
+    for (const auto &range : next_level) {
+      if (range.n_parts > 0) {
+        level.push_back(range);
+      }
+    }
+  }
+
+  return parts;
+}
+
+auto best_move(const Adjacency &graph, const std::vector<std::size_t> &parts,
+               std::size_t cell) -> std::pair<std::size_t, std::ptrdiff_t> {
+  /**
+   * @brief Find the neighbouring part a cell has the most faces with, and the
+   * reduction of cut faces obtained by moving it there.
+   */
+  // neighbour parts of a cell are few, a sorted small vector is enough
+  std::vector<std::pair<std::size_t, std::ptrdiff_t>> connections;
+  for (auto i = graph.offsets[cell]; i < graph.offsets[cell + 1]; ++i) {
+    auto part = parts[graph.ids[i]];
+    auto iter = std::find_if(connections.begin(), connections.end(),
+                             [&](const auto &c) { return c.first == part; });
+    if (iter == connections.end()) {
+      connections.emplace_back(part, 1);
+    } else {
+      ++iter->second;
+    }
+  }
+  std::sort(connections.begin(), connections.end());
+
+  std::ptrdiff_t own = 0;
+  auto target = no_part;
+  std::ptrdiff_t target_connections = 0;
+  for (const auto &[part, count] : connections) {
+    if (part == parts[cell]) {
+      own = count;
+    } else if (count > target_connections) {
+      target = part;
+      target_connections = count;
+    }
+  }
+
+  return {target, target_connections - own};
+}
+
+void refine(const Adjacency &graph, std::vector<std::size_t> &parts,
+            std::size_t n_parts) {
+  /**
+   * @brief Greedy boundary refinement. Candidate moves are evaluated in
+   * parallel, then applied in cell order if they still reduce the cut and
+   * keep part sizes within the allowed imbalance.
+   */
+  auto n_cells = parts.size();
+  auto average = static_cast<double>(n_cells) / static_cast<double>(n_parts);
+  auto max_size = static_cast<std::size_t>(std::ceil(average * (1. + imbalance)));
+  auto min_size = static_cast<std::size_t>(std::floor(average * (1. - imbalance)));
+
+  std::vector<std::size_t> sizes(n_parts, 0);
+  for (auto part : parts) {
+    ++sizes[part];
+  }
+
+  std::vector<char> is_candidate(n_cells);
+  for (std::size_t pass = 0; pass < max_refinement_passes; ++pass) {
+    parallel_for(n_cells, grain, [&](std::size_t begin, std::size_t end) {
+      for (auto cell = begin; cell < end; ++cell) {
+        is_candidate[cell] = best_move(graph, parts, cell).second > 0 ? 1 : 0;
+      }
+    });
+
+    std::size_t n_moves = 0;
+    for (std::size_t cell = 0; cell < n_cells; ++cell) {
+      if (is_candidate[cell] == 0) {
+        continue;
+      }
+
+      auto [target, gain] = best_move(graph, parts, cell);
+      if (gain <= 0 || sizes[target] + 1 > max_size ||
+          sizes[parts[cell]] - 1 < min_size) {
+        continue;
+      }
+
+      --sizes[parts[cell]];
+      ++sizes[target];
+      parts[cell] = target;
+      ++n_moves;
+    }
+
+    if (n_moves == 0) {
+      break;
+    }
+  }
+}
+
+struct PartitionTopology {
+  Adjacency elements_of;
+  Adjacency parts_of;
+  Adjacency part_elements;
+};
+
+auto partition_topology(const Mesh &mesh, const std::vector<std::size_t> &parts)
+    -> PartitionTopology {
+  /**
+   * @brief Elements and parts using each vertex of a partitioned mesh.
+   */
+  auto n_elements = mesh.elements().has_value() ? mesh.elements()->size() : 0;
+  if (parts.size() != n_elements) {
+    throw std::runtime_error(
+        "unvpp::extract_subdomain(): Parts count does not match elements count");
+  }
+
+  PartitionTopology topology;
+  topology.elements_of = vertex_elements(mesh);
+
+  const auto &elements_of = topology.elements_of;
+  topology.parts_of = build_adjacency(
+      mesh.vertices().size(), grain,
+      [&](std::size_t v_id, std::vector<std::size_t> &ids) {
+        auto first = ids.size();
+        for (auto i = elements_of.offsets[v_id];
+             i < elements_of.offsets[v_id + 1]; ++i) {
+          ids.push_back(parts[elements_of.ids[i]]);
+        }
+        std::sort(ids.begin() + first, ids.end());
+        ids.erase(std::unique(ids.begin() + first, ids.end()), ids.end());
+      });
+
+  // elements of each part, by counting sort
+  auto n_parts =
+      parts.empty() ? 0 : *std::max_element(parts.begin(), parts.end()) + 1;
+  auto &part_elements = topology.part_elements;
+  part_elements.offsets.assign(n_parts + 1, 0);
+  for (auto part : parts) {
+    ++part_elements.offsets[part + 1];
+  }
+  for (std::size_t part = 0; part < n_parts; ++part) {
+    part_elements.offsets[part + 1] += part_elements.offsets[part];
+  }
+
+  part_elements.ids.resize(n_elements);
+  auto cursor = part_elements.offsets;
+  for (std::size_t e_id = 0; e_id < n_elements; ++e_id) {
+    part_elements.ids[cursor[parts[e_id]]++] = e_id;
+  }
+
+  return topology;
+}
+
+auto extract(const Mesh &mesh, const std::vector<std::size_t> &parts,
+             std::size_t part, const PartitionTopology &topology)
+    -> Subdomain {
+  const auto &parts_of = topology.parts_of;
+  const auto &part_elements = topology.part_elements;
+
+  std::vector<std::size_t> elements_ids;
+  if (part < part_elements.offsets.size() - 1) {
+    elements_ids.assign(
+        part_elements.ids.begin() + part_elements.offsets[part],
+        part_elements.ids.begin() + part_elements.offsets[part + 1]);
+  }
+
+  std::vector<std::size_t> vertices_ids;
+  for (auto e_id : elements_ids) {
+    const auto &ids = mesh.elements().value()[e_id].vertices_ids();
+    vertices_ids.insert(vertices_ids.end(), ids.begin(), ids.end());
+  }
+  std::sort(vertices_ids.begin(), vertices_ids.end());
+  vertices_ids.erase(std::unique(vertices_ids.begin(), vertices_ids.end()),
+                     vertices_ids.end());
+
+  auto local_id = [](const std::vector<std::size_t> &global_ids,
+                     std::size_t global_id) {
+    auto iter =
+        std::lower_bound(global_ids.begin(), global_ids.end(), global_id);
+    if (iter == global_ids.end() || *iter != global_id) {
+      return no_part;
+    }
+    return static_cast<std::size_t>(iter - global_ids.begin());
+  };
+
+  std::vector<std::array<double, 3>> vertices;
+  vertices.reserve(vertices_ids.size());
+  for (auto v_id : vertices_ids) {
+    vertices.push_back(mesh.vertices()[v_id]);
+  }
+
+  std::optional<std::vector<Element>> elements;
+  if (mesh.elements().has_value()) {
+    elements.emplace();
+    elements->reserve(elements_ids.size());
+    for (auto e_id : elements_ids) {
+      const auto &element = mesh.elements().value()[e_id];
+      auto ids = element.vertices_ids();
+      for (auto &v_id : ids) {
+        v_id = local_id(vertices_ids, v_id);
+      }
+      elements->emplace_back(std::move(ids), element.type());
+    }
+  }
+
+  std::optional<std::vector<Group>> groups;
+  if (mesh.groups().has_value()) {
+    groups.emplace();
+    for (const auto &group : mesh.groups().value()) {
+      const auto &global_ids = group.type() == GroupType::Vertex
+                                   ? vertices_ids
+                                   : elements_ids;
+      // element types are those of the members kept in the part
+      ElementTypes types;
+      GroupMembers ids;
+      for (auto id : group.elements_ids()) {
+        auto local = local_id(global_ids, id);
+        if (local != no_part) {
+          ids.push_back(local);
+          if (group.type() == GroupType::Element) {
+            types.insert(mesh.elements().value()[id].type());
+          }
+        }
+      }
+
+      groups->emplace_back(group.name(), group.type(), std::move(ids));
+      for (auto element_type : types) {
+        groups->back().add_element_type(element_type);
+      }
+    }
+  }
+
+  std::map<std::size_t, std::vector<std::size_t>> shared;
+  std::vector<std::size_t> halo_elements;
+  const auto &elements_of = topology.elements_of;
+
+  for (std::size_t local = 0; local < vertices_ids.size(); ++local) {
+    auto v_id = vertices_ids[local];
+    if (parts_of.degree(v_id) < 2) {
+      continue;
+    }
+
+    for (auto i = parts_of.offsets[v_id]; i < parts_of.offsets[v_id + 1]; ++i) {
+      if (parts_of.ids[i] != part) {
+        shared[parts_of.ids[i]].push_back(local);
+      }
+    }
+    for (auto i = elements_of.offsets[v_id]; i < elements_of.offsets[v_id + 1];
+         ++i) {
+      if (parts[elements_of.ids[i]] != part) {
+        halo_elements.push_back(elements_of.ids[i]);
+      }
+    }
+  }
+
+  std::sort(halo_elements.begin(), halo_elements.end());
+  halo_elements.erase(std::unique(halo_elements.begin(), halo_elements.end()),
+                      halo_elements.end());
+
+  std::vector<Interface> interfaces;
+  for (auto &[neighbour, shared_vertices] : shared) {
+    interfaces.push_back(Interface{neighbour, std::move(shared_vertices)});
+  }
+
+  return Subdomain{Mesh(std::move(vertices), std::move(elements),
+                        std::move(groups), mesh.unit_system()),
+                   std::move(vertices_ids), std::move(elements_ids),
+                   std::move(interfaces), std::move(halo_elements)};
+}
+
+} // namespace
+
+auto partition(const Mesh &mesh, std::size_t n_parts)
+    -> std::vector<std::size_t> {
+  if (n_parts == 0) {
+    throw std::runtime_error("unvpp::partition(): Number of parts must be "
+                             "greater than zero");
+  }
+
+  if (!mesh.elements().has_value()) {
+    return {};
+  }
+
+  const auto &elements = mesh.elements().value();
+  std::size_t dimension = 0;
+  for (const auto &element : elements) {
+    dimension = std::max(dimension, element_dimension(element.type()));
+  }
+
+  std::vector<std::size_t> cells;
+  for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+    if (element_dimension(elements[e_id].type()) == dimension) {
+      cells.push_back(e_id);
+    }
+  }
+
+  auto cells_parts = coordinate_bisection(cells_centroids(mesh, cells), n_parts);
+
+  auto elements_of = vertex_elements(mesh);
+  auto graph = dual_graph(mesh, elements_of, cells, dimension);
+  refine(graph, cells_parts, n_parts);
+
+  std::vector<std::size_t> parts(elements.size(), no_part);
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    parts[cells[i]] = cells_parts[i];
+  }
+
+  // lower dimension elements follow a cell using all of their vertices, or
+  // at least one of them
+  parallel_for(elements.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto e_id = begin; e_id < end; ++e_id) {
+      if (parts[e_id] != no_part) {
+        continue;
+      }
+
+      const auto &ids = elements[e_id].vertices_ids();
+      auto touching = no_part;
+      auto owner = no_part;
+
+      for (auto i = elements_of.offsets[ids.front()];
+           i < elements_of.offsets[ids.front() + 1] && owner == no_part; ++i) {
+        auto cell = elements_of.ids[i];
+        if (element_dimension(elements[cell].type()) != dimension) {
+          continue;
+        }
+        if (touching == no_part) {
+          touching = cell;
+        }
+
+        const auto &cell_ids = elements[cell].vertices_ids();
+        auto uses_all = std::all_of(ids.begin(), ids.end(), [&](auto v_id) {
+          return std::find(cell_ids.begin(), cell_ids.end(), v_id) !=
+                 cell_ids.end();
+        });
+        if (uses_all) {
+          owner = cell;
+        }
+      }
+
+      if (owner == no_part) {
+        owner = touching;
+      }
+      parts[e_id] = owner == no_part ? 0 : parts[owner];
+    }
+  });
+
+  return parts;
+}
+
+auto extract_subdomain(const Mesh &mesh,
+                       const std::vector<std::size_t> &parts,
+                       std::size_t part) -> Subdomain {
+  return extract(mesh, parts, part, partition_topology(mesh, parts));
+}
+
+auto extract_subdomains(const Mesh &mesh, const std::vector<std::size_t> &parts)
+    -> std::vector<Subdomain> {
+  auto topology = partition_topology(mesh, parts);
+  auto n_parts = topology.part_elements.offsets.size() - 1;
+
+  std::vector<std::optional<Subdomain>> subdomains(n_parts);
+  parallel_for(n_parts, 1, [&](std::size_t begin, std::size_t end) {
+    for (auto part = begin; part < end; ++part) {
+      subdomains[part] = extract(mesh, parts, part, topology);
+    }
+  });
+
+  std::vector<Subdomain> result;
+  result.reserve(n_parts);
+  for (auto &subdomain : subdomains) {
+    result.push_back(std::move(*subdomain));
+  }
+  return result;
+}
+
+} // namespace unvpp
@@ -0,0 +1,142 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "placement.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "parallel.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace unvpp {
+
+namespace {
+
+// blocks are aligned to transparent huge pages, so that each huge page is
+// touched by a single task
+constexpr std::uintptr_t huge_page_size = std::uintptr_t{1} << 21;
+
+// stride of the touching loop, at most the size of a page
+constexpr std::uintptr_t touch_stride = 4096;
+
+auto block_bounds(std::uintptr_t begin, std::uintptr_t end)
+    -> std::vector<std::uintptr_t> {
+  /**
+   * @brief Split [begin, end) into one contiguous block per task of the
+   * current executor, with inner bounds on huge page boundaries.
+   *
+   * @return std::vector<std::uintptr_t> Bounds of the blocks, block i being
+   * [bounds[i], bounds[i + 1]).
+   */
+  auto n_blocks = std::clamp<std::size_t>((end - begin) / huge_page_size, 1,
+                                          current_executor().concurrency());
+
+  std::vector<std::uintptr_t> bounds{begin};
+  for (std::size_t block = 1; block < n_blocks; ++block) {
+    auto bound = begin + (end - begin) * block / n_blocks;
+    bound = (bound + huge_page_size - 1) & ~(huge_page_size - 1);
+    bounds.push_back(std::clamp(bound, bounds.back(), end));
+  }
+  bounds.push_back(end);
+  return bounds;
+}
+
+} // namespace
+
+void first_touch(void *data, std::size_t bytes) {
+  /**
+   * @brief Touch the pages of an allocated but not yet written range in
+   * parallel, one block per task of the current executor, so that each page
+   * is allocated on the NUMA node of the task writing it first. On Linux the
+   * range is advised to transparent huge pages before.
+   *
+   * The range holds no object yet, so zero bytes are written to it, and the
+   * values later stored there keep the placement of its pages.
+   *
+   * @param data beginning of the range
+   * @param bytes size of the range
+   */
+  if (bytes == 0) {
+    return;
+  }
+
+  auto begin = reinterpret_cast<std::uintptr_t>(data);
+  auto end = begin + bytes;
+
+#ifdef __linux__
+  auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  auto first_page = (begin + page_size - 1) & ~(page_size - 1);
+  auto last_page = end & ~(page_size - 1);
+  if (first_page < last_page) {
+    // an advice only, unsupported kernels keep regular pages
+    madvise(reinterpret_cast<void *>(first_page), last_page - first_page,
+            MADV_HUGEPAGE);
+  }
+#endif
+
+  auto bounds = block_bounds(begin, end);
+  parallel_for(bounds.size() - 1, 1, [&](std::size_t first, std::size_t last) {
+    for (auto block = first; block < last; ++block) {
+      for (auto address = bounds[block]; address < bounds[block + 1];
+           address = (address + touch_stride) & ~(touch_stride - 1)) {
+        *reinterpret_cast<volatile unsigned char *>(address) = 0;
+      }
+    }
+  });
+}
+
+void place_connectivity(std::vector<Element> &elements) {
+  /**
+   * @brief Reallocate the vertices ids of each element from the task of the
+   * current executor owning the block of the elements array it lies in, see
+   * first_touch(), so that they are allocated on the same NUMA node.
+   *
+   * @param elements elements, read by a single thread
+   */
+  auto begin = reinterpret_cast<std::uintptr_t>(elements.data());
+  auto bounds = block_bounds(begin, begin + elements.size() * sizeof(Element));
+  if (bounds.size() <= 2) {
+    return;
+  }
+
+  auto element_index = [&](std::uintptr_t address) {
+    return (address - begin + sizeof(Element) - 1) / sizeof(Element);
+  };
+
+  parallel_for(bounds.size() - 1, 1, [&](std::size_t first, std::size_t last) {
+    for (auto block = first; block < last; ++block) {
+      for (auto i = element_index(bounds[block]);
+           i < element_index(bounds[block + 1]); ++i) {
+        auto &ids = elements[i].vertices_ids();
+        ids = std::vector<std::size_t>(ids.begin(), ids.end());
+      }
+    }
+  });
+}
+
+} // namespace unvpp
@@ -0,0 +1,540 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/quality.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "common.h"
+#include "parallel.h"
+#include "shapes.h"
+#include "topology.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of elements handled by one parallel chunk
+constexpr std::size_t grain = 4096;
+
+// number of chunks in flight per executor thread, each with its accumulator
+constexpr std::size_t chunks_per_thread = 4;
+
+constexpr double degrees_per_radian = 57.295779513082320876798;
+
+template <ElementType Type>
+constexpr auto ideal_jacobian() -> double {
+  /**
+   * @brief Corner scaled Jacobian of the regular element of a type, used to
+   * scale Jacobians so that regular elements score 1.
+   */
+  if constexpr (Type == ElementType::Triangle || Type == ElementType::Wedge) {
+    return 0.86602540378443864676; // sin(60 degrees)
+  } else if constexpr (Type == ElementType::Tetra) {
+    return 0.70710678118654752440; // 1 / sqrt(2)
+  } else {
+    return 1.;
+  }
+}
+
+auto make_histogram(QualityMetric metric) -> Histogram {
+  Histogram histogram;
+  switch (metric) {
+  case QualityMetric::AspectRatio:
+    histogram.bounds = {1., 1.5, 2., 3., 5., 10., 20., 50., 100., 1000.};
+    break;
+  case QualityMetric::Skewness:
+    for (std::size_t i = 0; i <= 10; ++i) {
+      histogram.bounds.push_back(0.1 * static_cast<double>(i));
+    }
+    break;
+  case QualityMetric::NonOrthogonality:
+    for (std::size_t i = 0; i <= 9; ++i) {
+      histogram.bounds.push_back(10. * static_cast<double>(i));
+    }
+    break;
+  case QualityMetric::MinJacobian:
+    for (std::size_t i = 0; i <= 10; ++i) {
+      histogram.bounds.push_back(-1. + 0.2 * static_cast<double>(i));
+    }
+    break;
+  }
+  histogram.counts.assign(histogram.bounds.size() - 1, 0);
+  return histogram;
+}
+
+void add_value(Histogram &histogram, double value) {
+  auto iter = std::upper_bound(histogram.bounds.begin(),
+                               histogram.bounds.end(), value);
+  auto bin = static_cast<std::size_t>(
+      std::max<std::ptrdiff_t>(iter - histogram.bounds.begin() - 1, 0));
+  ++histogram.counts[std::min(bin, histogram.counts.size() - 1)];
+
+  histogram.min = histogram.count == 0 ? value : std::min(histogram.min, value);
+  histogram.max = histogram.count == 0 ? value : std::max(histogram.max, value);
+  histogram.sum += value;
+  ++histogram.count;
+}
+
+void merge_histogram(Histogram &into, const Histogram &from) {
+  if (from.count == 0) {
+    return;
+  }
+  for (std::size_t bin = 0; bin < into.counts.size(); ++bin) {
+    into.counts[bin] += from.counts[bin];
+  }
+  into.min = into.count == 0 ? from.min : std::min(into.min, from.min);
+  into.max = into.count == 0 ? from.max : std::max(into.max, from.max);
+  into.sum += from.sum;
+  into.count += from.count;
+}
+
+/* Histograms and worst elements of a set of elements */
+class Accumulator {
+public:
+  explicit Accumulator(std::size_t n_worst) : _n_worst(n_worst) {
+    for (auto &type_histograms : histograms) {
+      for (std::size_t metric = 0; metric < quality_metrics_count; ++metric) {
+        type_histograms[metric] =
+            make_histogram(static_cast<QualityMetric>(metric));
+      }
+    }
+  }
+
+  void record(ElementType type, QualityMetric metric, std::size_t e_id,
+              double value) {
+    auto m = static_cast<std::size_t>(metric);
+    add_value(histograms[static_cast<std::size_t>(type)][m], value);
+    keep_worst(metric, QualityOffender{e_id, value});
+  }
+
+  void merge(const Accumulator &other) {
+    for (std::size_t type = 0; type < histograms.size(); ++type) {
+      for (std::size_t m = 0; m < quality_metrics_count; ++m) {
+        merge_histogram(histograms[type][m], other.histograms[type][m]);
+      }
+      negative_volumes[type] += other.negative_volumes[type];
+    }
+    for (std::size_t m = 0; m < quality_metrics_count; ++m) {
+      for (const auto &offender : other.worst[m]) {
+        keep_worst(static_cast<QualityMetric>(m), offender);
+      }
+    }
+  }
+
+  void clear() {
+    /**
+     * @brief Reset to an empty accumulator, keeping the allocated bins and
+     * worst lists for reuse.
+     */
+    for (auto &type_histograms : histograms) {
+      for (auto &histogram : type_histograms) {
+        std::fill(histogram.counts.begin(), histogram.counts.end(), 0);
+        histogram.count = 0;
+        histogram.min = 0.;
+        histogram.max = 0.;
+        histogram.sum = 0.;
+      }
+    }
+    for (auto &list : worst) {
+      list.clear();
+    }
+    negative_volumes.fill(0);
+  }
+
+  std::array<std::array<Histogram, quality_metrics_count>, 6> histograms;
+  std::array<std::vector<QualityOffender>, quality_metrics_count> worst;
+  std::array<std::size_t, 6> negative_volumes{};
+
+private:
+  void keep_worst(QualityMetric metric, QualityOffender offender) {
+    /**
+     * @brief Insert an element in the sorted list of worst elements of a
+     * metric. Ties are broken by element id, so that the list does not
+     * depend on the order in which chunks are merged.
+     */
+    auto is_worse = [metric](const QualityOffender &a,
+                             const QualityOffender &b) {
+      if (a.value != b.value) {
+        return metric == QualityMetric::MinJacobian ? a.value < b.value
+                                                    : a.value > b.value;
+      }
+      return a.element < b.element;
+    };
+
+    auto &list = worst[static_cast<std::size_t>(metric)];
+    if (_n_worst == 0 ||
+        (list.size() == _n_worst && !is_worse(offender, list.back()))) {
+      return;
+    }
+
+    list.insert(std::upper_bound(list.begin(), list.end(), offender, is_worse),
+                offender);
+    if (list.size() > _n_worst) {
+      list.pop_back();
+    }
+  }
+
+  std::size_t _n_worst;
+};
+
+auto angle(const Point &a, const Point &b) -> double {
+  /**
+   * @brief Angle in degrees between two vectors, zero if one is null.
+   */
+  auto lengths = norm(a) * norm(b);
+  if (lengths == 0.) {
+    return 0.;
+  }
+  return std::acos(std::clamp(dot(a, b) / lengths, -1., 1.)) *
+         degrees_per_radian;
+}
+
+auto polygon_skewness(const std::array<Point, 4> &corners,
+                      std::size_t n_corners) -> double {
+  /**
+   * @brief Equiangular skewness of a triangle or a quad.
+   */
+  auto ideal = n_corners == 3 ? 60. : 90.;
+  auto min_angle = 180.;
+  auto max_angle = 0.;
+
+  for (std::size_t i = 0; i < n_corners; ++i) {
+    auto to_previous =
+        subtract(corners[(i + n_corners - 1) % n_corners], corners[i]);
+    auto to_next = subtract(corners[(i + 1) % n_corners], corners[i]);
+    if (norm(to_previous) == 0. || norm(to_next) == 0.) {
+      return 1.;
+    }
+
+    auto corner_angle = angle(to_previous, to_next);
+    min_angle = std::min(min_angle, corner_angle);
+    max_angle = std::max(max_angle, corner_angle);
+  }
+
+  auto skewness = std::max((max_angle - ideal) / (180. - ideal),
+                           (ideal - min_angle) / ideal);
+  return std::clamp(skewness, 0., 1.);
+}
+
+auto face_geometry(const std::array<Point, 4> &corners, std::size_t n_corners)
+    -> FaceGeometry {
+  return n_corners == 3
+             ? triangle_geometry(corners[0], corners[1], corners[2])
+             : quad_geometry(corners[0], corners[1], corners[2], corners[3]);
+}
+
+auto corners_center(const Mesh &mesh, const Element &element) -> Point {
+  const auto &ids = element.vertices_ids();
+  auto n_corners = corners_count(element.type());
+
+  Point center{0., 0., 0.};
+  for (std::size_t c = 0; c < n_corners; ++c) {
+    const auto &vertex =
+        mesh.vertices()[ids[corner_position(element.type(), ids.size(), c)]];
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      center[axis] += vertex[axis] / static_cast<double>(n_corners);
+    }
+  }
+  return center;
+}
+
+/* Quality evaluation of the elements of a mesh */
+class QualityEvaluator {
+public:
+  QualityEvaluator(const Mesh &mesh, const Adjacency &elements_of)
+      : _mesh(mesh), _elements(mesh.elements().value()),
+        _elements_of(elements_of) {}
+
+  template <ElementType Type>
+  void evaluate(std::size_t e_id, Accumulator &accumulator) const {
+    constexpr auto n_corners = corners_count(Type);
+    const auto &ids = _elements[e_id].vertices_ids();
+    if (ids.size() < n_corners) {
+      throw std::runtime_error("unvpp::analyze_quality(): Element " +
+                               std::to_string(e_id) + " has " +
+                               std::to_string(ids.size()) +
+                               " vertices, expected at least " +
+                               std::to_string(n_corners));
+    }
+
+    std::array<std::size_t, n_corners> vertices_ids;
+    std::array<Point, n_corners> corners;
+    for (std::size_t c = 0; c < n_corners; ++c) {
+      vertices_ids[c] = ids[corner_position(Type, ids.size(), c)];
+      corners[c] = _mesh.vertices()[vertices_ids[c]];
+    }
+
+    accumulator.record(Type, QualityMetric::AspectRatio, e_id,
+                       aspect_ratio<Type>(corners));
+
+    if constexpr (Type == ElementType::Triangle || Type == ElementType::Quad) {
+      std::array<Point, 4> polygon{};
+      std::copy(corners.begin(), corners.end(), polygon.begin());
+      accumulator.record(Type, QualityMetric::Skewness, e_id,
+                         polygon_skewness(polygon, n_corners));
+      accumulator.record(Type, QualityMetric::MinJacobian, e_id,
+                         face_min_jacobian(corners) / ideal_jacobian<Type>());
+    } else {
+      double skewness = 0.;
+      for (const auto &local : cell_faces<Type>()) {
+        skewness = std::max(skewness,
+                            polygon_skewness(face_corners(corners, local),
+                                             local.n_corners));
+      }
+      accumulator.record(Type, QualityMetric::Skewness, e_id, skewness);
+
+      auto [min_jacobian, inverted] = cell_min_jacobian<Type>(corners);
+      accumulator.record(Type, QualityMetric::MinJacobian, e_id,
+                         min_jacobian / ideal_jacobian<Type>());
+      if (inverted) {
+        ++accumulator.negative_volumes[static_cast<std::size_t>(Type)];
+      }
+
+      auto non_orthogonality =
+          cell_non_orthogonality<Type>(e_id, vertices_ids, corners);
+      if (non_orthogonality.has_value()) {
+        accumulator.record(Type, QualityMetric::NonOrthogonality, e_id,
+                           non_orthogonality.value());
+      }
+    }
+  }
+
+private:
+  template <ElementType Type, std::size_t N>
+  static auto aspect_ratio(const std::array<Point, N> &corners) -> double {
+    auto shortest = std::numeric_limits<double>::infinity();
+    auto longest = 0.;
+    for (const auto &edge : element_edges<Type>()) {
+      auto length = norm(subtract(corners[edge[1]], corners[edge[0]]));
+      shortest = std::min(shortest, length);
+      longest = std::max(longest, length);
+    }
+    return shortest > 0. ? longest / shortest
+                         : std::numeric_limits<double>::infinity();
+  }
+
+  template <std::size_t N>
+  static auto face_corners(const std::array<Point, N> &corners,
+                           const LocalFace &local) -> std::array<Point, 4> {
+    std::array<Point, 4> face{};
+    for (std::size_t c = 0; c < local.n_corners; ++c) {
+      face[c] = corners[local.corners[c]];
+    }
+    return face;
+  }
+
+  template <std::size_t N>
+  static auto face_min_jacobian(const std::array<Point, N> &corners)
+      -> double {
+    /**
+     * @brief Smallest scaled Jacobian of a face, measured against the face
+     * normal.
+     */
+    std::array<Point, 4> polygon{};
+    std::copy(corners.begin(), corners.end(), polygon.begin());
+    auto area_vector = face_geometry(polygon, N).area_vector;
+    auto area = norm(area_vector);
+    if (area == 0.) {
+      return 0.;
+    }
+
+    auto min_jacobian = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < N; ++i) {
+      auto to_next = subtract(corners[(i + 1) % N], corners[i]);
+      auto to_previous = subtract(corners[(i + N - 1) % N], corners[i]);
+      auto lengths = norm(to_next) * norm(to_previous);
+      auto jacobian =
+          lengths > 0. ? dot(cross(to_next, to_previous), area_vector) /
+                             (lengths * area)
+                       : 0.;
+      min_jacobian = std::min(min_jacobian, jacobian);
+    }
+    return min_jacobian;
+  }
+
+  template <ElementType Type, std::size_t N>
+  static auto cell_min_jacobian(const std::array<Point, N> &corners)
+      -> std::pair<double, bool> {
+    /**
+     * @brief Smallest scaled Jacobian at the corners of a cell, and whether
+     * a corner Jacobian determinant is not positive.
+     */
+    constexpr auto neighbours_table = corner_neighbours<Type>();
+
+    auto min_jacobian = std::numeric_limits<double>::infinity();
+    auto inverted = false;
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto &neighbours = neighbours_table[i];
+      auto e0 = subtract(corners[neighbours[0]], corners[i]);
+      auto e1 = subtract(corners[neighbours[1]], corners[i]);
+      auto e2 = subtract(corners[neighbours[2]], corners[i]);
+
+      auto determinant = dot(cross(e0, e1), e2);
+      auto lengths = norm(e0) * norm(e1) * norm(e2);
+      inverted = inverted || determinant <= 0.;
+      min_jacobian = std::min(min_jacobian,
+                              lengths > 0. ? determinant / lengths : 0.);
+    }
+    return {min_jacobian, inverted};
+  }
+
+  template <ElementType Type, std::size_t N>
+  auto cell_non_orthogonality(std::size_t e_id,
+                              const std::array<std::size_t, N> &vertices_ids,
+                              const std::array<Point, N> &corners) const
+      -> std::optional<double> {
+    /**
+     * @brief Largest non-orthogonality angle over the faces a cell shares
+     * with other cells, nothing if the cell has no neighbour.
+     */
+    auto center = average(corners);
+    std::optional<double> worst;
+
+    for (const auto &local : cell_faces<Type>()) {
+      auto neighbour = face_neighbour(e_id, vertices_ids, local);
+      if (!neighbour.has_value()) {
+        continue;
+      }
+
+      auto face = face_geometry(face_corners(corners, local), local.n_corners);
+      auto centers = subtract(corners_center(_mesh, _elements[*neighbour]),
+                              center);
+      auto face_angle = angle(face.area_vector, centers);
+      face_angle = std::min(face_angle, 180. - face_angle);
+      worst = std::max(worst.value_or(0.), face_angle);
+    }
+    return worst;
+  }
+
+  template <std::size_t N>
+  auto face_neighbour(std::size_t e_id,
+                      const std::array<std::size_t, N> &vertices_ids,
+                      const LocalFace &local) const
+      -> std::optional<std::size_t> {
+    /**
+     * @brief The other cell using the first three corners of a face.
+     */
+    auto v0 = vertices_ids[local.corners[0]];
+    auto v1 = vertices_ids[local.corners[1]];
+    auto v2 = vertices_ids[local.corners[2]];
+
+    for (auto i = _elements_of.offsets[v0]; i < _elements_of.offsets[v0 + 1];
+         ++i) {
+      auto other = _elements_of.ids[i];
+      if (other == e_id || !is_volume_type(_elements[other].type())) {
+        continue;
+      }
+
+      const auto &ids = _elements[other].vertices_ids();
+      if (std::find(ids.begin(), ids.end(), v1) != ids.end() &&
+          std::find(ids.begin(), ids.end(), v2) != ids.end()) {
+        return other;
+      }
+    }
+    return std::nullopt;
+  }
+
+  const Mesh &_mesh;
+  const std::vector<Element> &_elements;
+  const Adjacency &_elements_of;
+};
+
+} // namespace
+
+auto analyze_quality(const Mesh &mesh, const QualityOptions &options)
+    -> QualityReport {
+  /**
+   * @brief Compute quality statistics of the elements of a mesh in parallel.
+   *
+   * @param mesh the mesh
+   * @param options number of worst elements to keep
+   * @return QualityReport
+   * @throw std::runtime_error If an element has fewer vertices than its type
+   * corners.
+   */
+  Accumulator total(options.n_worst);
+
+  if (mesh.elements().has_value()) {
+    auto elements_of = vertex_elements(mesh);
+    auto evaluator = QualityEvaluator(mesh, elements_of);
+    const auto &elements = mesh.elements().value();
+
+    // chunks run in batches of a few per executor thread, whose accumulators
+    // are merged in chunk order, so sums do not depend on the executor, and
+    // then reused, so memory does not grow with the mesh
+    auto n_chunks = chunks_count(elements.size(), grain);
+    auto batch_size = std::min(
+        n_chunks, chunks_per_thread * current_executor().concurrency());
+    std::vector<Accumulator> chunks(batch_size, Accumulator(options.n_worst));
+
+    for (std::size_t first_chunk = 0; first_chunk < n_chunks;
+         first_chunk += batch_size) {
+      auto first = first_chunk * grain;
+      auto last = std::min(elements.size(), (first_chunk + batch_size) * grain);
+
+      parallel_for_chunks(last - first, grain, [&](std::size_t chunk_index,
+                                                   std::size_t begin,
+                                                   std::size_t end) {
+        auto &chunk = chunks[chunk_index];
+        for (auto e_id = first + begin; e_id < first + end; ++e_id) {
+          switch (elements[e_id].type()) {
+          case ElementType::Line:
+            break;
+          case ElementType::Triangle:
+            evaluator.evaluate<ElementType::Triangle>(e_id, chunk);
+            break;
+          case ElementType::Quad:
+            evaluator.evaluate<ElementType::Quad>(e_id, chunk);
+            break;
+          case ElementType::Tetra:
+            evaluator.evaluate<ElementType::Tetra>(e_id, chunk);
+            break;
+          case ElementType::Wedge:
+            evaluator.evaluate<ElementType::Wedge>(e_id, chunk);
+            break;
+          case ElementType::Hex:
+            evaluator.evaluate<ElementType::Hex>(e_id, chunk);
+            break;
+          }
+        }
+      });
+
+      for (std::size_t c = 0; c < chunks_count(last - first, grain); ++c) {
+        total.merge(chunks[c]);
+        chunks[c].clear();
+      }
+    }
+  }
+
+  QualityReport report;
+  report.histograms = std::move(total.histograms);
+  report.worst = std::move(total.worst);
+  report.negative_volumes = total.negative_volumes;
+  return report;
+}
+
+} // namespace unvpp
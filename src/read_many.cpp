@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <numeric>
+
+#include "parallel.h"
+
+namespace unvpp {
+
+auto read_many(const std::vector<std::filesystem::path> &paths,
+               const BatchOptions &options) -> std::vector<ReadResult> {
+  /**
+   * @brief Read many UNV mesh files concurrently.
+   *
+   * Pending files are kept sorted by decreasing size. An idle worker takes
+   * the largest pending file fitting in the remaining memory budget, or
+   * waits for running reads to finish when none fits.
+   *
+   * @param paths paths to the UNV files
+   * @param options threads count, memory bound and executor
+   * @return std::vector<ReadResult> One result per path, in input order.
+   */
+  std::vector<ReadResult> results(paths.size());
+  std::vector<std::uintmax_t> sizes(paths.size(), 0);
+
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    results[i].path = paths[i];
+    std::error_code error;
+    auto size = std::filesystem::file_size(paths[i], error);
+    // unreadable files are scheduled anyway, and fail in read()
+    sizes[i] = error ? 0 : size;
+  }
+
+  std::vector<std::size_t> order(paths.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+    return sizes[lhs] > sizes[rhs];
+  });
+  std::list<std::size_t> pending(order.begin(), order.end());
+
+  auto budget = static_cast<std::uintmax_t>(options.max_bytes_in_flight);
+  std::uintmax_t in_flight{0};
+  std::size_t n_running{0};
+
+  std::mutex mutex;
+  std::condition_variable finished;
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!pending.empty()) {
+      auto next = std::find_if(pending.begin(), pending.end(), [&](auto i) {
+        return budget == 0 || n_running == 0 || in_flight + sizes[i] <= budget;
+      });
+
+      if (next == pending.end()) {
+        finished.wait(lock);
+        continue;
+      }
+
+      auto i = *next;
+      pending.erase(next);
+      in_flight += sizes[i];
+      ++n_running;
+      lock.unlock();
+
+      try {
+        results[i].mesh = read(paths[i]);
+      } catch (const std::exception &e) {
+        results[i].error = e.what();
+      } catch (...) {
+        results[i].error = "unvpp::read_many(): Unknown error";
+      }
+
+      lock.lock();
+      in_flight -= sizes[i];
+      --n_running;
+      finished.notify_all();
+    }
+  };
+
+  auto &executor =
+      options.executor != nullptr ? *options.executor : current_executor();
+  auto n_threads =
+      options.n_threads == 0 ? executor.concurrency() : options.n_threads;
+  n_threads = std::max<std::size_t>(std::min(n_threads, paths.size()), 1);
+
+  // a worker waits for budget only while another one is reading, so workers
+  // run by the executor one after the other never block
+  executor.parallel_for(n_threads, [&](std::size_t /*worker_index*/) {
+    ExecutorScope scope(executor);
+    worker();
+  });
+
+  return results;
+}
+
+} // namespace unvpp
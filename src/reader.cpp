@@ -24,6 +24,9 @@ SOFTWARE.
 
 #include "reader.h"
 #include "common.h"
+#include "parallel.h"
+#include "placement.h"
+#include <algorithm>
 #include <charconv>
 #include <cmath>
 #include <fast_float/fast_float.h>
@@ -154,6 +157,24 @@ auto inline read_n_integers(std::string_view line, std::size_t n)
   return numbers;
 }
 
+auto inline count_numbers(std::string_view line) -> std::size_t {
+  /**
+   * @brief Count the blank separated numbers of a line.
+   *
+   *
+   * @param line The line to read from.
+   * @return std::size_t The count of numbers.
+   *
+   */
+  std::size_t count = 0;
+  auto pos = line.find_first_not_of(' ');
+  while (pos != std::string_view::npos) {
+    ++count;
+    pos = line.find_first_not_of(' ', line.find(' ', pos));
+  }
+  return count;
+}
+
 auto inline read_first_number(std::string_view line) -> std::size_t {
   /**
    * @brief Read the first scalar value from a line.
@@ -342,8 +363,31 @@ auto Reader::groups() noexcept -> std::vector<Group> & {
   return _groups;
 }
 
+auto Reader::vertices_unv_ids() noexcept -> std::vector<std::size_t> & {
+  /**
+   * @brief Get the UNV ids of the vertices read in slice mode.
+   *
+   * @return The vertices UNV ids array.
+   *
+   */
+  return _vertices_unv_ids;
+}
+
+auto Reader::elements_unv_ids() noexcept -> std::vector<std::size_t> & {
+  /**
+   * @brief Get the UNV ids of the elements read in slice mode.
+   *
+   * @return The elements UNV ids array.
+   *
+   */
+  return _elements_unv_ids;
+}
+
 Reader::Reader(const std::filesystem::path &path) : _stream(path) {}
 
+Reader::Reader(const std::filesystem::path &path, Slice slice)
+    : _stream(path), _slice(slice) {}
+
 void Reader::read_tags() {
   /**
    * @brief Read the tags from the stream.
@@ -360,40 +404,377 @@ void Reader::read_tags() {
       continue;
     }
 
-    switch (tag_kind_from_str(_temp_line_view)) {
-    case TagKind::Units:
-      read_units();
-      break;
+    read_tag(tag_kind_from_str(_temp_line_view));
+  }
+}
 
-    case TagKind::Vertices:
+void Reader::read_tag(TagKind kind) {
+  /**
+   * @brief Read a tag whose first line was just read from the stream.
+   *
+   * @param kind kind of the tag.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  switch (kind) {
+  case TagKind::Units:
+    read_units();
+    break;
+
+  case TagKind::Vertices:
+    if (_slice.has_value()) {
+      read_vertices_slice();
+    } else if (_ids_only) {
+      index_vertices();
+    } else {
       read_vertices();
+    }
+    break;
+
+  case TagKind::Elements:
+    if (_ids_only) {
+      index_elements();
+      break;
+    }
+
+    if (_slice.has_value()) {
+      // slices keep UNV vertices ids in elements connectivity
+      read_elements_slice();
       break;
+    }
 
-    case TagKind::Elements:
+    {
+      auto first_element = _elements.size();
+      auto tag_position = _stream.position();
+      auto tag_line_number = _stream.line_number();
       read_elements();
 
       // adjust unv vertices index ordering for each element
-      adjust_vertices_ids();
-      break;
+      adjust_vertices_ids(first_element, tag_position, tag_line_number);
+    }
+    break;
 
-    case TagKind::Group:
-      read_groups();
+  case TagKind::Group: {
+    auto first_group = _groups.size();
+    read_groups();
 
-      // adjust unv elements index ordering for each group
-      adjust_group_elements();
-      break;
+    // adjust unv elements index ordering for each group
+    if (_slice.has_value()) {
+      filter_slice_groups(first_group);
+    } else {
+      adjust_group_elements(first_group);
+    }
+    break;
+  }
 
-    case TagKind::DOFs:
-      read_dofs();
-      break;
+  case TagKind::DOFs:
+    read_dofs();
+    break;
 
-    default:
-      // Unsupported tags are skipped.
+  case TagKind::Results:
+  case TagKind::NodalData:
+    if (_results_handler) {
+      read_results(kind);
+    } else {
       skip_tag();
     }
+    break;
+
+  default:
+    read_unsupported();
   }
 }
 
+void Reader::seek(std::streampos position, std::size_t line_number) {
+  /**
+   * @brief Move the stream to a position, typically the line following a
+   * tag first line, see index_datasets().
+   *
+   * @param position position in the file.
+   * @param line_number number of the last line before `position`.
+   *
+   */
+  _stream.seek(position, line_number);
+}
+
+void Reader::set_results_handler(
+    std::function<void(ResultDataset &&)> handler) {
+  /**
+   * @brief Read results datasets (2414 and 55), and pass each of them to
+   * `handler` once parsed. Without a handler they are skipped.
+   *
+   * @param handler callable invoked with each results dataset.
+   *
+   */
+  _results_handler = std::move(handler);
+}
+
+void Reader::set_dataset_handlers(const DatasetRegistry *registry) {
+  /**
+   * @brief Pass the record lines of datasets unvpp does not read to the
+   * handlers registered for them. Other datasets are skipped.
+   *
+   * @param registry handlers by dataset number, which must outlive the
+   * reader, or null to skip all datasets unvpp does not read.
+   *
+   */
+  _dataset_handlers = registry;
+}
+
+void Reader::set_validation(Validation validation) {
+  /**
+   * @brief Select how invalid records are handled, see ReadOptions.
+   *
+   * @param validation strict validation throws at the first invalid record.
+   *
+   */
+  _strict = validation == Validation::Strict;
+}
+
+void Reader::read_unsupported() {
+  /**
+   * @brief Pass a dataset unvpp does not read, whose number line was just
+   * read, to its registered handler, or skip it.
+   *
+   * The dataset is read in a single buffer reused across datasets, and its
+   * lines are passed as views into it.
+   *
+   */
+  auto has_handlers =
+      _dataset_handlers != nullptr && !_dataset_handlers->empty();
+  if (!has_handlers && !_coordinate_systems_enabled) {
+    skip_tag();
+    return;
+  }
+
+  std::size_t dataset{0};
+  auto first = _temp_line.find_first_not_of(' ');
+  auto [p, ec] = std::from_chars(
+      _temp_line.data() + std::min(first, _temp_line.size()),
+      _temp_line.data() + _temp_line.size(), dataset);
+  if (ec != std::errc()) {
+    skip_tag();
+    return;
+  }
+
+  const auto *handler =
+      has_handlers ? _dataset_handlers->find(dataset) : nullptr;
+  auto is_coordinate_systems = _coordinate_systems_enabled &&
+                               dataset == COORDINATE_SYSTEMS_DATASET;
+  if (handler == nullptr && !is_coordinate_systems) {
+    skip_tag();
+    return;
+  }
+
+  _dataset_content.clear();
+  _stream.skip_dataset(&_dataset_content);
+
+  _dataset_lines.clear();
+  std::string_view content(_dataset_content);
+  while (!content.empty()) {
+    auto end = std::min(content.find('\n'), content.size());
+    auto line = content.substr(0, end);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    _dataset_lines.push_back(line);
+    content.remove_prefix(std::min(end + 1, content.size()));
+  }
+
+  if (is_coordinate_systems) {
+    read_coordinate_systems(_dataset_lines);
+  }
+  if (handler != nullptr) {
+    (*handler)(dataset, _dataset_lines);
+  }
+}
+
+void Reader::read_coordinate_systems(
+    const std::vector<std::string_view> &lines) {
+  /**
+   * @brief Read the coordinate systems of a 2420 dataset, given as a part
+   * UID and name line, then six lines per system: label and type, name, the
+   * three local axes and the origin in the global frame.
+   *
+   * @param lines the dataset lines.
+   *
+   * @throw std::runtime_error If a system has an unknown type.
+   *
+   */
+  constexpr std::size_t header_lines = 2;
+  constexpr std::size_t record_lines = 6;
+
+  for (auto first = header_lines; first + record_lines <= lines.size();
+       first += record_lines) {
+    auto ids = read_n_integers(lines[first], 2);
+    CoordinateSystem system;
+    system.type = ids[1];
+    if (system.type > 2) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_coordinate_systems(): ") +
+          "Unknown type " + std::to_string(system.type) +
+          " of coordinate system " + std::to_string(ids[0]));
+    }
+
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      system.axes[axis] = read_double_triplet(lines[first + 2 + axis]);
+    }
+    system.origin = read_double_triplet(lines[first + 5]);
+    _coordinate_systems[ids[0]] = system;
+  }
+}
+
+void Reader::set_vertices_transform(bool si_units, bool coordinate_systems) {
+  /**
+   * @brief Select the transforms applied by transform_vertices(), see
+   * ReadOptions. Coordinate systems of vertices are recorded while reading
+   * them, so this must be set before reading.
+   *
+   * @param si_units convert coordinates to meters.
+   * @param coordinate_systems express coordinates in the global frame.
+   *
+   */
+  _si_units = si_units;
+  _coordinate_systems_enabled = coordinate_systems;
+}
+
+void Reader::set_memory_placement(MemoryPlacement placement) {
+  /**
+   * @brief Select the placement of the vertices and elements arrays, see
+   * MemoryPlacement. Pages are touched once the arrays are allocated, so this
+   * must be set before reading.
+   *
+   * @param placement memory placement.
+   *
+   */
+  _first_touch = placement == MemoryPlacement::FirstTouch;
+}
+
+void Reader::set_ids_only(bool ids_only) {
+  /**
+   * @brief Only index the ids of vertices and elements, and the types of
+   * elements, without parsing vertices coordinates nor elements
+   * connectivity. Groups are then resolved as when reading the whole mesh,
+   * while vertices and elements are left empty.
+   *
+   * @param ids_only whether to only index ids.
+   *
+   */
+  _ids_only = ids_only;
+}
+
+void Reader::transform_vertices() {
+  /**
+   * @brief Apply the coordinate system of each vertex and the units length
+   * scale to the vertices coordinates, once all tags are read.
+   *
+   * The scale is folded into the affine map of each coordinate system, so
+   * each vertex is loaded and stored once, in a single parallel pass. Runs
+   * of vertices sharing a cartesian system go through a branch free loop of
+   * fixed size matrix products, which the compiler can vectorize.
+   *
+   * @throw std::runtime_error If the length scale is not positive.
+   *
+   */
+  constexpr std::size_t grain = 4096;
+  constexpr double radians_per_degree = 0.017453292519943295769;
+  // "SI: Meter (newton)" in the units codes table
+  constexpr std::size_t si_units_code = 1;
+
+  double scale = 1.;
+  if (_si_units) {
+    auto length_scale = units_system.length_scale();
+    if (!(length_scale > 0.) || !std::isfinite(length_scale)) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::transform_vertices(): ") +
+          "Invalid length scale " + std::to_string(length_scale));
+    }
+    scale = 1. / length_scale;
+    // coordinates are now in meters, so the original code no longer applies
+    units_system = UnitsSystem(si_units_code, 1.);
+  }
+
+  // affine map of each run of vertices, scale included
+  if (!_coordinate_systems_enabled || _vertices_frames.empty()) {
+    _vertices_frames.assign(1, {0, 0});
+  }
+  std::vector<CoordinateSystem> maps(_vertices_frames.size());
+  for (std::size_t run = 0; run < maps.size(); ++run) {
+    auto iter = _coordinate_systems.find(_vertices_frames[run].second);
+    auto &map = maps[run];
+    if (!_coordinate_systems_enabled || iter == _coordinate_systems.end()) {
+      // undefined systems are the global frame
+      map.axes = {{{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}}};
+    } else {
+      map = iter->second;
+    }
+    for (auto &axis : map.axes) {
+      for (auto &x : axis) {
+        x *= scale;
+      }
+    }
+    for (auto &x : map.origin) {
+      x *= scale;
+    }
+  }
+
+  auto affine = [](const CoordinateSystem &map,
+                   const std::array<double, 3> &point) {
+    auto global = map.origin;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        global[k] += point[axis] * map.axes[axis][k];
+      }
+    }
+    return global;
+  };
+
+  // local cylindrical (r, theta, z) or spherical (r, theta, phi) coordinates
+  // to local cartesian ones
+  auto cartesian = [](std::size_t type, const std::array<double, 3> &point)
+      -> std::array<double, 3> {
+    auto theta = point[1] * radians_per_degree;
+    if (type == 1) {
+      return {point[0] * std::cos(theta), point[0] * std::sin(theta),
+              point[2]};
+    }
+    auto phi = point[2] * radians_per_degree;
+    return {point[0] * std::sin(theta) * std::cos(phi),
+            point[0] * std::sin(theta) * std::sin(phi),
+            point[0] * std::cos(theta)};
+  };
+
+  parallel_for(_vertices.size(), grain, [&](std::size_t begin,
+                                            std::size_t end) {
+    auto run = static_cast<std::size_t>(
+        std::upper_bound(_vertices_frames.begin(), _vertices_frames.end(),
+                         begin,
+                         [](std::size_t v, const auto &frame) {
+                           return v < frame.first;
+                         }) -
+        _vertices_frames.begin() - 1);
+
+    while (begin < end) {
+      auto run_end = run + 1 < _vertices_frames.size()
+                         ? std::min(end, _vertices_frames[run + 1].first)
+                         : end;
+      const auto &map = maps[run];
+      if (map.type == 0) {
+        for (auto v = begin; v < run_end; ++v) {
+          _vertices[v] = affine(map, _vertices[v]);
+        }
+      } else {
+        for (auto v = begin; v < run_end; ++v) {
+          _vertices[v] = affine(map, cartesian(map.type, _vertices[v]));
+        }
+      }
+      begin = run_end;
+      ++run;
+    }
+  });
+}
+
 void Reader::read_units() {
   /**
    * @brief Read system of untis tag 164  .
@@ -443,11 +824,21 @@ void Reader::read_vertices() {
   /**
    * @brief Read vertices tag 2411.
    *
+   * Records are counted first, so that vertices and ids map are allocated
+   * once.
    *
    * @throw std::runtime_error If the stream does not contain a valid unv file.
    *
    */
-  std::size_t current_point_id{0};
+  auto extent = vertices_extent();
+  _vertices.reserve(_vertices.size() + extent.n_records);
+  _unv_vertex_id_to_ordered_id_map.reserve(_vertices.size() +
+                                           extent.n_records);
+  if (_first_touch) {
+    first_touch(_vertices.data() + _vertices.size(),
+                (_vertices.capacity() - _vertices.size()) *
+                    sizeof(std::array<double, 3>));
+  }
 
   std::string line;
   while (_stream.read_line(line)) {
@@ -457,7 +848,18 @@ void Reader::read_vertices() {
       break;
     }
 
-    auto point_unv_id = read_first_number(line_view);
+    std::size_t point_unv_id{0};
+    if (_coordinate_systems_enabled) {
+      // the second field is the coordinate system the vertex is defined in
+      auto fields = read_n_integers(line_view, 2);
+      point_unv_id = fields[0];
+      if (_vertices_frames.empty() ||
+          _vertices_frames.back().second != fields[1]) {
+        _vertices_frames.emplace_back(_vertices.size(), fields[1]);
+      }
+    } else {
+      point_unv_id = read_first_number(line_view);
+    }
 
     if (!_stream.read_line(line)) {
       throw std::runtime_error(std::string("unvpp::Reader::read_vertices(): ") +
@@ -466,9 +868,15 @@ void Reader::read_vertices() {
     }
 
     line_view = std::string_view(line);
+    if (!_unv_vertex_id_to_ordered_id_map.insert(point_unv_id,
+                                                 _vertices.size()) &&
+        _strict) {
+      throw std::runtime_error(std::string("unvpp::Reader::read_vertices(): ") +
+                               "Duplicate vertex id " +
+                               std::to_string(point_unv_id) + " at line " +
+                               std::to_string(_stream.line_number() - 1));
+    }
     _vertices.emplace_back(read_double_triplet(line_view));
-
-    _unv_vertex_id_to_ordered_id_map[point_unv_id] = current_point_id++;
   }
 }
 
@@ -476,11 +884,20 @@ void Reader::read_elements() {
   /**
    * @brief Read elements tag 2412.
    *
+   * Records are counted first, so that elements and ids map are allocated
+   * once.
    *
    * @throw std::runtime_error If the stream does not contain a valid unv file.
    *
    */
-  std::size_t current_element_id{0};
+  auto extent = elements_extent();
+  _elements.reserve(_elements.size() + extent.n_records);
+  _unv_element_id_to_ordered_id_map.reserve(_elements.size() +
+                                            extent.n_records);
+  if (_first_touch) {
+    first_touch(_elements.data() + _elements.size(),
+                (_elements.capacity() - _elements.size()) * sizeof(Element));
+  }
 
   std::string line;
   while (_stream.read_line(line)) {
@@ -496,52 +913,232 @@ void Reader::read_elements() {
     auto element_type = element_type_from_element_id(records[1]);
     auto vertex_count = records[5];
 
-    if (!_stream.read_line(line)) {
-      throw std::runtime_error(std::string("unvpp::Reader::read_elements(): ") +
-                                "Failed to read element vertices at line " +
-                                std::to_string(_stream.line_number()));
+    if (is_beam_type(element_type)) {
+      skip_lines(1);
     }
 
-    if (is_beam_type(element_type)) {
-      _stream.read_line(line);
+    auto inserted = _unv_element_id_to_ordered_id_map.insert(element_unv_id,
+                                                             _elements.size());
+    check_element(element_unv_id, inserted, element_type, vertex_count);
+    _elements.emplace_back(read_element_vertices(vertex_count), element_type);
+  }
+}
+
+void Reader::check_element(std::size_t unv_id, bool inserted,
+                           ElementType type, std::size_t vertex_count) {
+  /**
+   * @brief With strict validation, reject an element record whose id was
+   * already read, or with fewer vertices than its type corners.
+   *
+   * @param unv_id UNV id of the element.
+   * @param inserted whether the id was new to the elements ids map.
+   * @param type type of the element.
+   * @param vertex_count number of vertices of the element.
+   *
+   * @throw std::runtime_error If the record is invalid.
+   *
+   */
+  if (!_strict) {
+    return;
+  }
+
+  // the record first line, and the beam line following it
+  auto line_number = _stream.line_number() - (is_beam_type(type) ? 1 : 0);
+  if (!inserted) {
+    throw std::runtime_error(std::string("unvpp::Reader::check_element(): ") +
+                             "Duplicate element id " + std::to_string(unv_id) +
+                             " at line " + std::to_string(line_number));
+  }
+  if (vertex_count < corners_count(type)) {
+    throw std::runtime_error(std::string("unvpp::Reader::check_element(): ") +
+                             "Element " + std::to_string(unv_id) + " has " +
+                             std::to_string(vertex_count) +
+                             " vertices at line " +
+                             std::to_string(line_number));
+  }
+}
+
+auto Reader::read_element_vertices(std::size_t vertex_count)
+    -> std::vector<std::size_t> {
+  /**
+   * @brief Read the vertices ids record of an element, which spans several
+   * lines of 8 ids for elements with more than 8 vertices.
+   *
+   * @param vertex_count number of vertices of the element.
+   * @return The UNV ids of the element vertices.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  std::vector<std::size_t> vertices_ids;
+
+  while (vertices_ids.size() < vertex_count) {
+    if (!_stream.read_line(_temp_line) || is_separator(_temp_line)) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_element_vertices(): ") +
+          "Failed to read element vertices at line " +
+          std::to_string(_stream.line_number()));
     }
 
-    line_view = std::string_view(line);
-    auto vertices_ids = read_n_integers(line_view, vertex_count);
-    _elements.emplace_back(std::move(vertices_ids), element_type);
+    _temp_line_view = std::string_view(_temp_line);
+    auto n_ids = std::min(count_numbers(_temp_line_view),
+                          vertex_count - vertices_ids.size());
+    if (n_ids == 0) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_element_vertices(): ") +
+          "No vertices ids at line " + std::to_string(_stream.line_number()));
+    }
 
-    _unv_element_id_to_ordered_id_map[element_unv_id] = current_element_id++;
+    auto ids = read_n_integers(_temp_line_view, n_ids);
+    if (vertices_ids.empty() && ids.size() == vertex_count) {
+      // most records fit on one line, whose ids are used as they are
+      return ids;
+    }
+    vertices_ids.reserve(vertex_count);
+    vertices_ids.insert(vertices_ids.end(), ids.begin(), ids.end());
   }
+
+  return vertices_ids;
 }
 
-void Reader::adjust_vertices_ids() {
+void Reader::adjust_vertices_ids(std::size_t first_element,
+                                 std::streampos tag_position,
+                                 std::size_t tag_line_number) {
   /**
    * @brief Adjust vertices ids to match the order in which they were read.
    *
+   * Unknown vertices ids map to the first vertex, unless validation is
+   * strict. The lines of element records are not kept, the elements tag is
+   * walked again to report the line of an unknown id.
    *
-   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   * @param first_element index of the first element read from the current
+   * tag, elements read from previous tags are already adjusted.
+   * @param tag_position position of the line following the elements tag line.
+   * @param tag_line_number number of the elements tag line.
+   *
+   * @throw std::runtime_error If validation is strict and an element refers
+   * to an unknown vertex.
    *
    */
-  for (auto &element : _elements) {
-    for (auto &v_id : element.vertices_ids()) {
-      v_id = _unv_vertex_id_to_ordered_id_map[v_id];
+  for (auto e_id = first_element; e_id < _elements.size(); ++e_id) {
+    auto &vertices_ids = _elements[e_id].vertices_ids();
+    for (std::size_t i = 0; i < vertices_ids.size(); ++i) {
+      auto v_id = _unv_vertex_id_to_ordered_id_map.find(vertices_ids[i]);
+      if (!v_id.has_value() && _strict) {
+        auto unv_id = vertices_ids[i];
+        auto line_number = element_vertex_line(e_id - first_element, i,
+                                               tag_position, tag_line_number);
+        throw std::runtime_error(
+            std::string("unvpp::Reader::adjust_vertices_ids(): ") +
+            "Unknown vertex id " + std::to_string(unv_id) + " at line " +
+            std::to_string(line_number));
+      }
+      vertices_ids[i] = v_id.value_or(0);
     }
   }
 }
 
-void Reader::adjust_group_elements() {
+auto Reader::element_vertex_line(std::size_t record, std::size_t vertex,
+                                 std::streampos tag_position,
+                                 std::size_t tag_line_number) -> std::size_t {
   /**
-   * @brief Adjust group elements ids to match the order in which they were
-   * read, and add the type of each element to group unique elements set.
+   * @brief Line of a vertex id of an element record, found by walking the
+   * records of the elements tag from its start. Only used to report errors,
+   * the stream is left in the tag.
    *
-   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   * @param record index of the record in the tag.
+   * @param vertex position of the vertex in the element vertices.
+   * @param tag_position position of the line following the elements tag line.
+   * @param tag_line_number number of the elements tag line.
+   * @return The line number.
    *
    */
-  for (auto &group : _groups) {
-    for (auto &e_id : group.elements_ids()) {
-      e_id = _unv_element_id_to_ordered_id_map[e_id];
-      group.add_element_type(_elements[e_id].type());
+  constexpr std::size_t ids_per_line = 8;
+
+  _stream.seek(tag_position, tag_line_number);
+  for (std::size_t r = 0; r < record; ++r) {
+    _stream.read_line(_temp_line);
+    auto records = read_n_integers(_temp_line, 6);
+    skip_lines(is_beam_type(element_type_from_element_id(records[1])) ? 1 : 0);
+    skip_element_vertices(records[5]);
+  }
+
+  _stream.read_line(_temp_line);
+  auto records = read_n_integers(_temp_line, 6);
+  auto beam = is_beam_type(element_type_from_element_id(records[1]));
+  return _stream.line_number() + (beam ? 1 : 0) + 1 + vertex / ids_per_line;
+}
+
+void Reader::adjust_group_elements(std::size_t first_group) {
+  /**
+   * @brief Adjust group elements (or vertices) ids to match the order in
+   * which they were read, and add the type of each element to group unique
+   * elements set.
+   *
+   * Unknown ids map to the first element (or vertex), unless validation is
+   * strict.
+   *
+   * @param first_group index of the first group read from the current tag,
+   * groups read from previous tags are already adjusted.
+   *
+   * @throw std::runtime_error If validation is strict and a group refers to
+   * an unknown element or vertex.
+   *
+   */
+  for (auto g_id = first_group; g_id < _groups.size(); ++g_id) {
+    auto &group = _groups[g_id];
+    auto is_vertex_group = group.type() == GroupType::Vertex;
+    const auto &ids_map = is_vertex_group ? _unv_vertex_id_to_ordered_id_map
+                                          : _unv_element_id_to_ordered_id_map;
+    GroupMembers ids;
+    std::size_t member{0};
+    for (auto unv_id : group.elements_ids()) {
+      auto id = ids_map.find(unv_id);
+      if (!id.has_value() && _strict) {
+        // members are listed two per line after the group name line
+        auto line_number =
+            _group_name_lines[g_id - first_group] + 1 + member / 2;
+        throw std::runtime_error(
+            std::string("unvpp::Reader::adjust_group_elements(): ") +
+            "Unknown " + (is_vertex_group ? "vertex" : "element") + " id " +
+            std::to_string(unv_id) + " in group " + group.name() +
+            " at line " + std::to_string(line_number));
+      }
+      ids.push_back(id.value_or(0));
+      if (!is_vertex_group && elements_count() > 0) {
+        group.add_element_type(element_type(id.value_or(0)));
+      }
+      ++member;
     }
+    group.set_elements_ids(std::move(ids));
+  }
+}
+
+void Reader::filter_slice_groups(std::size_t first_group) {
+  /**
+   * @brief Restrict the groups read from the current tag to the vertices or
+   * elements of the slice, and convert their members to slice indices.
+   *
+   * @param first_group index of the first group read from the current tag.
+   *
+   */
+  for (auto g_id = first_group; g_id < _groups.size(); ++g_id) {
+    auto &group = _groups[g_id];
+    const auto &ids_map = group.type() == GroupType::Vertex
+                              ? _unv_vertex_id_to_ordered_id_map
+                              : _unv_element_id_to_ordered_id_map;
+    GroupMembers ids;
+    for (auto unv_id : group.elements_ids()) {
+      auto id = ids_map.find(unv_id);
+      if (!id.has_value()) {
+        continue;
+      }
+      ids.push_back(*id);
+      if (group.type() == GroupType::Element) {
+        group.add_element_type(_elements[*id].type());
+      }
+    }
+    group.set_elements_ids(std::move(ids));
   }
 }
 
@@ -555,6 +1152,7 @@ void Reader::read_groups() {
    */
   constexpr std::size_t n_element_pos = 7;
 
+  _group_name_lines.clear();
   std::string line;
   while (_stream.read_line(line)) {
     std::string_view line_view(line);
@@ -568,6 +1166,7 @@ void Reader::read_groups() {
     if (!_stream.read_line(line)) {
       throw std::runtime_error("Failed to read group name");
     }
+    _group_name_lines.push_back(_stream.line_number());
 
     auto group_name_start = line.find_first_not_of(' ');
     auto group_name_end = line.find_last_not_of(' ');
@@ -606,14 +1205,28 @@ void Reader::read_dofs() {
     auto group_name = line.substr(group_name_start,
                                    group_name_end - group_name_start + 1);
 
-    std::vector<std::size_t> group_vertices;
+    GroupMembers group_vertices;
 
     while (_stream.read_line(line)) {
       if (is_separator(line)) {
         break;
       }
-      group_vertices.push_back(
-          _unv_vertex_id_to_ordered_id_map[read_first_number(line)]);
+
+      auto unv_id = read_first_number(line);
+      auto v_id = _unv_vertex_id_to_ordered_id_map.find(unv_id);
+      if (_slice.has_value()) {
+        if (v_id.has_value()) {
+          group_vertices.push_back(*v_id);
+        }
+        continue;
+      }
+      if (!v_id.has_value() && _strict) {
+        throw std::runtime_error(std::string("unvpp::Reader::read_dofs(): ") +
+                                 "Unknown vertex id " + std::to_string(unv_id) +
+                                 " in group " + group_name + " at line " +
+                                 std::to_string(_stream.line_number()));
+      }
+      group_vertices.push_back(v_id.value_or(0));
     }
 
     _groups.emplace_back(std::move(group_name), GroupType::Vertex,
@@ -642,7 +1255,7 @@ auto Reader::read_group_elements(std::size_t n_elements)
   }
 
   auto [elements, group_type] = read_group_elements_two_columns(n_elements - 1);
-  elements.push_back(read_group_elements_single_column().first.at(0));
+  elements.push_back(read_group_elements_single_column().first[0]);
 
   return std::make_pair(elements, group_type);
 }
@@ -660,8 +1273,7 @@ auto Reader::read_group_elements_two_columns(std::size_t n_elements)
    *
    */
   auto n_rows = n_elements / 2;
-  std::vector<size_t> elements;
-  elements.reserve(n_elements);
+  GroupMembers elements;
 
   auto group_type = GroupType::Element;
 
@@ -698,15 +1310,279 @@ auto Reader::read_group_elements_single_column() -> Reader::GroupDataPair {
   _temp_line_view = std::string_view(_temp_line);
 
   auto records = read_n_integers(_temp_line_view, 2);
-  auto element = std::vector<std::size_t>({records[1]});
+  GroupMembers element;
+  element.push_back(records[1]);
   auto group_type = records[0] == 8 ? GroupType::Element : GroupType::Vertex;
 
   return std::make_pair(element, group_type);
 }
 
-void Reader::skip_tag() {
+void Reader::read_vertices_slice() {
+  /**
+   * @brief Read the slice records of vertices tag 2411.
+   *
+   * Records are counted first, then only the slice records are parsed and
+   * the stream moves past the tag.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  auto extent = vertices_extent();
+  auto [begin, end] = slice_range(extent.n_records);
+  skip_lines(2 * begin);
+
+  std::string line;
+
+  _vertices.reserve(_vertices.size() + end - begin);
+  for (auto record = begin; record < end; ++record) {
+    if (!_stream.read_line(line)) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_vertices_slice(): ") +
+          "Unexpected end of file at line " +
+          std::to_string(_stream.line_number()));
+    }
+    auto point_unv_id = read_first_number(line);
+
+    if (!_stream.read_line(line)) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_vertices_slice(): ") +
+          "Unexpected end of file at line " +
+          std::to_string(_stream.line_number()));
+    }
+
+    if (!_unv_vertex_id_to_ordered_id_map.insert(point_unv_id,
+                                                 _vertices.size()) &&
+        _strict) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_vertices_slice(): ") +
+          "Duplicate vertex id " + std::to_string(point_unv_id) +
+          " at line " + std::to_string(_stream.line_number() - 1));
+    }
+    _vertices.emplace_back(read_double_triplet(line));
+    _vertices_unv_ids.push_back(point_unv_id);
+  }
+
+  _stream.seek(extent.end_position, extent.end_line_number);
+}
+
+void Reader::read_elements_slice() {
+  /**
+   * @brief Read the slice records of elements tag 2412.
+   *
+   * Records are counted first, then only the slice records are parsed and
+   * the stream moves past the tag.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  auto extent = elements_extent();
+  auto [begin, end] = slice_range(extent.n_records);
+
+  std::string line;
+
+  // reads a record first line, and skips the rest of the record when asked
+  auto next_record = [&](bool skip) -> std::optional<std::vector<std::size_t>> {
+    if (!_stream.read_line(line) || is_separator(line)) {
+      return std::nullopt;
+    }
+
+    auto records = read_n_integers(line, 6);
+    if (skip) {
+      skip_lines(is_beam_type(element_type_from_element_id(records[1])) ? 1
+                                                                         : 0);
+      skip_element_vertices(records[5]);
+    }
+    return records;
+  };
+
+  for (std::size_t record = 0; record < begin; ++record) {
+    next_record(true);
+  }
+
+  _elements.reserve(_elements.size() + end - begin);
+  for (auto record = begin; record < end; ++record) {
+    auto records = next_record(false);
+    if (!records.has_value()) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::read_elements_slice(): ") +
+          "Unexpected end of elements tag at line " +
+          std::to_string(_stream.line_number()));
+    }
+
+    auto element_unv_id = (*records)[0];
+    auto element_type = element_type_from_element_id((*records)[1]);
+    auto vertex_count = (*records)[5];
+
+    skip_lines(is_beam_type(element_type) ? 1 : 0);
+
+    auto inserted = _unv_element_id_to_ordered_id_map.insert(element_unv_id,
+                                                             _elements.size());
+    check_element(element_unv_id, inserted, element_type, vertex_count);
+    _elements.emplace_back(read_element_vertices(vertex_count), element_type);
+    _elements_unv_ids.push_back(element_unv_id);
+  }
+
+  _stream.seek(extent.end_position, extent.end_line_number);
+}
+
+void Reader::index_vertices() {
+  /**
+   * @brief Index the ids of vertices tag 2411, skipping the coordinates
+   * lines without parsing them.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  std::string line;
+  while (_stream.read_line(line)) {
+    if (is_separator(line)) {
+      break;
+    }
+
+    auto point_unv_id = read_first_number(line);
+    skip_lines(1);
+    _unv_vertex_id_to_ordered_id_map.insert(point_unv_id,
+                                            _n_indexed_vertices++);
+  }
+}
+
+void Reader::index_elements() {
+  /**
+   * @brief Index the ids and types of elements tag 2412, skipping the
+   * vertices ids records without parsing them.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file.
+   *
+   */
+  std::string line;
+  while (_stream.read_line(line)) {
+    if (is_separator(line)) {
+      break;
+    }
+
+    auto records = read_n_integers(line, 6);
+    auto type = element_type_from_element_id(records[1]);
+    skip_lines(is_beam_type(type) ? 1 : 0);
+    skip_element_vertices(records[5]);
+
+    _unv_element_id_to_ordered_id_map.insert(records[0],
+                                             _elements_types.size());
+    _elements_types.push_back(type);
+  }
+}
+
+auto Reader::element_type(std::size_t id) const -> ElementType {
+  return _ids_only ? _elements_types[id] : _elements[id].type();
+}
+
+auto Reader::elements_count() const noexcept -> std::size_t {
+  return _ids_only ? _elements_types.size() : _elements.size();
+}
+
+auto Reader::vertices_extent() -> TagExtent {
+  /**
+   * @brief Count the records of vertices tag 2411, two lines each, from the
+   * current position, which the stream is moved back to.
+   *
+   * @return The records count and the position past the tag.
+   *
+   */
+  auto tag_position = _stream.position();
+  auto tag_line_number = _stream.line_number();
+
+  std::size_t n_lines{0};
   while (_stream.read_line(_temp_line) && !is_separator(_temp_line)) {
+    ++n_lines;
+  }
+
+  TagExtent extent{n_lines / 2, _stream.position(), _stream.line_number()};
+  _stream.seek(tag_position, tag_line_number);
+  return extent;
+}
+
+auto Reader::elements_extent() -> TagExtent {
+  /**
+   * @brief Count the records of elements tag 2412 from the current position,
+   * which the stream is moved back to.
+   *
+   * Beam records have an extra line, and vertices ids of large elements span
+   * several lines, so records are walked through their first line.
+   *
+   * @return The records count and the position past the tag.
+   *
+   */
+  auto tag_position = _stream.position();
+  auto tag_line_number = _stream.line_number();
+
+  std::size_t n_records{0};
+  while (_stream.read_line(_temp_line) && !is_separator(_temp_line)) {
+    auto records = read_n_integers(_temp_line, 6);
+    skip_lines(is_beam_type(element_type_from_element_id(records[1])) ? 1 : 0);
+    skip_element_vertices(records[5]);
+    ++n_records;
+  }
+
+  TagExtent extent{n_records, _stream.position(), _stream.line_number()};
+  _stream.seek(tag_position, tag_line_number);
+  return extent;
+}
+
+void Reader::skip_element_vertices(std::size_t vertex_count) {
+  /**
+   * @brief Skip the vertices ids record of an element, counting its ids
+   * without parsing them.
+   *
+   * @param vertex_count number of vertices of the element.
+   *
+   */
+  std::size_t n_ids{0};
+  while (n_ids < vertex_count) {
+    if (!_stream.read_line(_temp_line) || is_separator(_temp_line)) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::skip_element_vertices(): ") +
+          "Failed to read element vertices at line " +
+          std::to_string(_stream.line_number()));
+    }
+    auto n_line_ids = count_numbers(_temp_line);
+    if (n_line_ids == 0) {
+      throw std::runtime_error(
+          std::string("unvpp::Reader::skip_element_vertices(): ") +
+          "No vertices ids at line " + std::to_string(_stream.line_number()));
+    }
+    n_ids += n_line_ids;
   }
 }
 
+auto Reader::slice_range(std::size_t n_records) const
+    -> std::pair<std::size_t, std::size_t> {
+  /**
+   * @brief Range of records of the slice rank, records are split into
+   * n_ranks contiguous ranges whose sizes differ by one at most.
+   *
+   * @param n_records number of records in the tag.
+   * @return The first record and one past the last record of the slice.
+   *
+   */
+  auto begin = n_records * _slice->rank / _slice->n_ranks;
+  auto end = n_records * (_slice->rank + 1) / _slice->n_ranks;
+  return {begin, end};
+}
+
+void Reader::skip_lines(std::size_t n_lines) {
+  for (std::size_t i = 0; i < n_lines; ++i) {
+    if (!_stream.read_line(_temp_line)) {
+      throw std::runtime_error(std::string("unvpp::Reader::skip_lines(): ") +
+                               "Unexpected end of file at line " +
+                               std::to_string(_stream.line_number()));
+    }
+  }
+}
+
+void Reader::skip_tag() {
+  /**
+   * @brief Skip the rest of the current dataset, without copying its lines.
+   */
+  _stream.skip_dataset();
+}
+
 } // namespace unvpp
@@ -23,18 +23,52 @@ SOFTWARE.
 */
 #pragma once
 
+#include "common.h"
+#include "id_map.h"
 #include "stream.h"
+#include "unvpp/datasets.h"
+#include "unvpp/results.h"
 #include "unvpp/unvpp.h"
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 
 namespace unvpp {
 
+/* Records count of a tag, and the stream position past its end */
+struct TagExtent {
+  std::size_t n_records;
+  std::streampos end_position;
+  std::size_t end_line_number;
+};
+
+/* UNV coordinate system (2420) */
+struct CoordinateSystem {
+  /**
+   * @param type 0 cartesian, 1 cylindrical, 2 spherical
+   * @param axes local axes in the global frame, one per row
+   * @param origin origin of the local frame in the global frame
+   */
+  std::size_t type{0};
+  std::array<std::array<double, 3>, 3> axes{};
+  std::array<double, 3> origin{};
+};
+
+/* Contiguous share of the vertices and elements records read by one rank */
+struct Slice {
+  std::size_t rank;
+  std::size_t n_ranks;
+};
+
+void check_input_file(const std::filesystem::path &path);
+
 class Reader {
 public:
   Reader() = delete;
   Reader(const std::filesystem::path &path);
+  Reader(const std::filesystem::path &path, Slice slice);
   Reader(Reader &other) = delete;
   Reader(Reader &&other) = delete;
   auto operator=(Reader &other) -> Reader & = delete;
@@ -42,6 +76,15 @@ public:
   ~Reader() = default;
 
   void read_tags();
+  void read_tag(TagKind kind);
+  void seek(std::streampos position, std::size_t line_number);
+  void set_results_handler(std::function<void(ResultDataset &&)> handler);
+  void set_dataset_handlers(const DatasetRegistry *registry);
+  void set_validation(Validation validation);
+  void set_vertices_transform(bool si_units, bool coordinate_systems);
+  void set_memory_placement(MemoryPlacement placement);
+  void set_ids_only(bool ids_only);
+  void transform_vertices();
   auto units() const noexcept -> const UnitsSystem &;
   auto vertices() const noexcept -> const std::vector<std::array<double, 3>> &;
   auto vertices() noexcept -> std::vector<std::array<double, 3>> &;
@@ -49,19 +92,46 @@ public:
   auto elements() noexcept -> std::vector<Element> &;
   auto groups() const noexcept -> const std::vector<Group> &;
   auto groups() noexcept -> std::vector<Group> &;
+  auto vertices_unv_ids() noexcept -> std::vector<std::size_t> &;
+  auto elements_unv_ids() noexcept -> std::vector<std::size_t> &;
 
 private:
   void skip_tag();
+  void skip_lines(std::size_t n_lines);
+  auto slice_range(std::size_t n_records) const
+      -> std::pair<std::size_t, std::size_t>;
+  auto vertices_extent() -> TagExtent;
+  auto elements_extent() -> TagExtent;
 
   void read_units();
   void read_vertices();
   void read_elements();
+  void read_vertices_slice();
+  void read_elements_slice();
+  void index_vertices();
+  void index_elements();
+  auto element_type(std::size_t id) const -> ElementType;
+  auto elements_count() const noexcept -> std::size_t;
+  auto read_element_vertices(std::size_t vertex_count)
+      -> std::vector<std::size_t>;
+  void skip_element_vertices(std::size_t vertex_count);
   void read_groups();
   void read_dofs();
-  void adjust_vertices_ids();
-  void adjust_group_elements();
+  void read_results(TagKind kind);
+  void read_unsupported();
+  void read_coordinate_systems(const std::vector<std::string_view> &lines);
+  void adjust_vertices_ids(std::size_t first_element,
+                           std::streampos tag_position,
+                           std::size_t tag_line_number);
+  void adjust_group_elements(std::size_t first_group);
+  auto element_vertex_line(std::size_t record, std::size_t vertex,
+                           std::streampos tag_position,
+                           std::size_t tag_line_number) -> std::size_t;
+  void check_element(std::size_t unv_id, bool inserted, ElementType type,
+                     std::size_t vertex_count);
+  void filter_slice_groups(std::size_t first_group);
 
-  using GroupDataPair = std::pair<std::vector<std::size_t>, GroupType>;
+  using GroupDataPair = std::pair<GroupMembers, GroupType>;
   auto read_group_elements(std::size_t n_elements) -> GroupDataPair;
   auto read_group_elements_two_columns(std::size_t n_elements) -> GroupDataPair;
   auto read_group_elements_single_column() -> GroupDataPair;
@@ -76,8 +146,40 @@ private:
   std::vector<Element> _elements;
   std::vector<Group> _groups;
 
-  std::unordered_map<std::size_t, std::size_t> _unv_vertex_id_to_ordered_id_map;
-  std::unordered_map<std::size_t, std::size_t>
-      _unv_element_id_to_ordered_id_map;
+  // set when reading a slice of the records, see read_partition()
+  std::optional<Slice> _slice;
+  std::vector<std::size_t> _vertices_unv_ids;
+  std::vector<std::size_t> _elements_unv_ids;
+
+  // results datasets are skipped unless a handler is set
+  std::function<void(ResultDataset &&)> _results_handler;
+
+  // other datasets are skipped unless a handler is registered
+  const DatasetRegistry *_dataset_handlers{nullptr};
+  std::string _dataset_content;
+  std::vector<std::string_view> _dataset_lines;
+
+  // strict validation rejects invalid records, see ReadOptions
+  bool _strict{false};
+  // vertices transform applied by transform_vertices(), see ReadOptions
+  bool _si_units{false};
+  bool _coordinate_systems_enabled{false};
+  std::unordered_map<std::size_t, CoordinateSystem> _coordinate_systems;
+  // coordinate system of the vertices, as runs of (first vertex, label)
+  std::vector<std::pair<std::size_t, std::size_t>> _vertices_frames;
+
+  // vertices and elements pages are touched first by the executor tasks
+  bool _first_touch{false};
+
+  // only ids are indexed, and elements types kept, see set_ids_only()
+  bool _ids_only{false};
+  std::size_t _n_indexed_vertices{0};
+  std::vector<ElementType> _elements_types;
+
+  // line of the name of each group read from the current groups tag
+  std::vector<std::size_t> _group_name_lines;
+
+  IdMap _unv_vertex_id_to_ordered_id_map;
+  IdMap _unv_element_id_to_ordered_id_map;
 };
 } // namespace unvpp
@@ -0,0 +1,422 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.h"
+#include "topology.h"
+
+namespace unvpp {
+
+namespace {
+
+using Point = std::array<double, 3>;
+
+// number of items handled by one parallel chunk
+constexpr std::size_t grain = 4096;
+
+// bits per axis of space-filling curve keys
+constexpr unsigned curve_bits = 21;
+
+auto inverse(const std::vector<std::size_t> &permutation)
+    -> std::vector<std::size_t> {
+  std::vector<std::size_t> inverse_permutation(permutation.size());
+  parallel_for(permutation.size(), grain,
+               [&](std::size_t begin, std::size_t end) {
+                 for (auto i = begin; i < end; ++i) {
+                   inverse_permutation[permutation[i]] = i;
+                 }
+               });
+  return inverse_permutation;
+}
+
+auto is_permutation(const std::vector<std::size_t> &permutation,
+                    std::size_t size) -> bool {
+  if (permutation.size() != size) {
+    return false;
+  }
+  std::vector<char> seen(size, 0);
+  for (auto i : permutation) {
+    if (i >= size || seen[i] != 0) {
+      return false;
+    }
+    seen[i] = 1;
+  }
+  return true;
+}
+
+auto morton_key(std::array<std::uint32_t, 3> x) -> std::uint64_t {
+  std::uint64_t key = 0;
+  for (auto bit = curve_bits; bit-- > 0;) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      key = (key << 1) | ((x[axis] >> bit) & 1U);
+    }
+  }
+  return key;
+}
+
+auto hilbert_key(std::array<std::uint32_t, 3> x) -> std::uint64_t {
+  /**
+   * @brief Hilbert curve index of a point with integer coordinates, using
+   * Skilling's transpose algorithm ("Programming the Hilbert curve", 2004).
+   */
+  constexpr std::uint32_t m = 1U << (curve_bits - 1);
+
+  // inverse undo
+  for (auto q = m; q > 1; q >>= 1) {
+    auto p = q - 1;
+    for (std::size_t i = 0; i < 3; ++i) {
+      if ((x[i] & q) != 0) {
+        x[0] ^= p;
+      } else {
+        auto t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // gray encode
+  for (std::size_t i = 1; i < 3; ++i) {
+    x[i] ^= x[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (auto q = m; q > 1; q >>= 1) {
+    if ((x[2] & q) != 0) {
+      t ^= q - 1;
+    }
+  }
+  for (auto &xi : x) {
+    xi ^= t;
+  }
+
+  return morton_key(x);
+}
+
+auto curve_order(const std::vector<Point> &points, Ordering ordering)
+    -> std::vector<std::size_t> {
+  /**
+   * @brief Order points along a space-filling curve.
+   *
+   * Points are quantized on a 2^21 grid spanning their bounding cube, and
+   * sorted by curve key (ties broken by index).
+   */
+  Point lower{};
+  Point upper{};
+  if (!points.empty()) {
+    lower = points.front();
+    upper = points.front();
+  }
+  for (const auto &point : points) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      lower[axis] = std::min(lower[axis], point[axis]);
+      upper[axis] = std::max(upper[axis], point[axis]);
+    }
+  }
+
+  auto extent = std::max({upper[0] - lower[0], upper[1] - lower[1],
+                          upper[2] - lower[2]});
+  auto scale = extent > 0. ? ((1U << curve_bits) - 1) / extent : 0.;
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> keys(points.size());
+  parallel_for(points.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      std::array<std::uint32_t, 3> x{};
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        x[axis] = static_cast<std::uint32_t>(
+            (points[i][axis] - lower[axis]) * scale);
+      }
+      keys[i] = {ordering == Ordering::Hilbert ? hilbert_key(x) : morton_key(x),
+                 i};
+    }
+  });
+
+  parallel_sort(keys.begin(), keys.end(), std::less<>());
+
+  std::vector<std::size_t> order(points.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    order[i] = keys[i].second;
+  }
+  return order;
+}
+
+auto element_centroids(const Mesh &mesh) -> std::vector<Point> {
+  const auto &vertices = mesh.vertices();
+  const auto &elements = mesh.elements().value();
+
+  std::vector<Point> centroids(elements.size());
+  parallel_for(elements.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto e_id = begin; e_id < end; ++e_id) {
+      const auto &ids = elements[e_id].vertices_ids();
+      Point centroid{0., 0., 0.};
+      for (auto v_id : ids) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          centroid[axis] += vertices[v_id][axis];
+        }
+      }
+      for (auto &x : centroid) {
+        x /= static_cast<double>(std::max<std::size_t>(ids.size(), 1));
+      }
+      centroids[e_id] = centroid;
+    }
+  });
+  return centroids;
+}
+
+struct DegreeLess {
+  // order graph vertices by increasing degree, then by index
+  const Adjacency *graph;
+
+  auto operator()(std::size_t lhs, std::size_t rhs) const -> bool {
+    auto d_lhs = graph->degree(lhs);
+    auto d_rhs = graph->degree(rhs);
+    return d_lhs < d_rhs || (d_lhs == d_rhs && lhs < rhs);
+  }
+};
+
+class CuthillMcKee {
+  /**
+   * @brief Reverse Cuthill-McKee ordering of a graph. Each connected
+   * component is traversed breadth first from a pseudo-peripheral vertex,
+   * visiting neighbours by increasing degree.
+   */
+public:
+  explicit CuthillMcKee(const Adjacency &graph)
+      : _graph(graph), _n(graph.offsets.size() - 1), _level(_n, unvisited) {}
+
+  auto order() -> std::vector<std::size_t> {
+    std::vector<std::size_t> by_degree(_n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    parallel_sort(by_degree.begin(), by_degree.end(), degree_less());
+
+    std::vector<char> numbered(_n, 0);
+    std::vector<std::size_t> order;
+    order.reserve(_n);
+
+    for (auto seed : by_degree) {
+      if (numbered[seed] != 0) {
+        continue;
+      }
+
+      auto start = pseudo_peripheral(seed);
+      auto first = order.size();
+      order.push_back(start);
+      numbered[start] = 1;
+
+      for (auto head = first; head < order.size(); ++head) {
+        auto v_id = order[head];
+        auto level_first = order.size();
+        for (auto i = _graph.offsets[v_id]; i < _graph.offsets[v_id + 1]; ++i) {
+          auto n_id = _graph.ids[i];
+          if (numbered[n_id] == 0) {
+            numbered[n_id] = 1;
+            order.push_back(n_id);
+          }
+        }
+        std::sort(order.begin() + level_first, order.end(), degree_less());
+      }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+  }
+
+private:
+  static constexpr std::size_t unvisited = std::numeric_limits<std::size_t>::max();
+
+  auto degree_less() const -> DegreeLess { return DegreeLess{&_graph}; }
+
+  auto last_level(std::size_t root, std::size_t &depth)
+      -> std::vector<std::size_t> {
+    // breadth first traversal recording the level of each vertex
+    std::vector<std::size_t> queue{root};
+    _level[root] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      auto v_id = queue[head];
+      for (auto i = _graph.offsets[v_id]; i < _graph.offsets[v_id + 1]; ++i) {
+        auto n_id = _graph.ids[i];
+        if (_level[n_id] == unvisited) {
+          _level[n_id] = _level[v_id] + 1;
+          queue.push_back(n_id);
+        }
+      }
+    }
+
+    depth = _level[queue.back()];
+    std::vector<std::size_t> last;
+    for (auto v_id : queue) {
+      if (_level[v_id] == depth) {
+        last.push_back(v_id);
+      }
+      _level[v_id] = unvisited;
+    }
+    return last;
+  }
+
+  auto pseudo_peripheral(std::size_t root) -> std::size_t {
+    // George-Liu iterations, bounded since each one is a full traversal
+    constexpr std::size_t max_iterations = 8;
+
+    std::size_t depth = 0;
+    auto last = last_level(root, depth);
+
+    for (std::size_t iteration = 0; iteration < max_iterations; ++iteration) {
+      auto candidate = *std::min_element(last.begin(), last.end(), degree_less());
+      std::size_t candidate_depth = 0;
+      auto candidate_last = last_level(candidate, candidate_depth);
+
+      if (candidate_depth <= depth) {
+        break;
+      }
+      root = candidate;
+      depth = candidate_depth;
+      last = std::move(candidate_last);
+    }
+    return root;
+  }
+
+  const Adjacency &_graph;
+  std::size_t _n;
+  std::vector<std::size_t> _level;
+};
+
+} // namespace
+
+auto Mesh::renumber(Ordering ordering) -> Permutation {
+  /**
+   * @brief Reorder vertices and elements to improve memory locality.
+   *
+   * With ReverseCuthillMcKee, vertices follow the RCM order of the vertex
+   * graph and elements are sorted by their lowest new vertex index. With
+   * Hilbert or Morton, vertices and element centroids are sorted along the
+   * space-filling curve. Connectivity and groups are updated accordingly, see
+   * permute().
+   *
+   * @param ordering ordering strategy
+   * @return Permutation The permutations applied to the mesh.
+   */
+  Permutation permutation;
+  auto n_elements = _elements.has_value() ? _elements->size() : 0;
+
+  if (ordering == Ordering::ReverseCuthillMcKee) {
+    auto graph = vertex_neighbours(*this);
+    permutation.vertices = CuthillMcKee(graph).order();
+
+    auto new_vertex_ids = inverse(permutation.vertices);
+    std::vector<std::pair<std::size_t, std::size_t>> keys(n_elements);
+
+    parallel_for(n_elements, grain, [&](std::size_t begin, std::size_t end) {
+      for (auto e_id = begin; e_id < end; ++e_id) {
+        auto key = std::numeric_limits<std::size_t>::max();
+        for (auto v_id : (*_elements)[e_id].vertices_ids()) {
+          key = std::min(key, new_vertex_ids[v_id]);
+        }
+        keys[e_id] = {key, e_id};
+      }
+    });
+
+    parallel_sort(keys.begin(), keys.end(), std::less<>());
+    permutation.elements.resize(n_elements);
+    for (std::size_t i = 0; i < n_elements; ++i) {
+      permutation.elements[i] = keys[i].second;
+    }
+  } else {
+    permutation.vertices = curve_order(_vertices, ordering);
+    if (_elements.has_value()) {
+      permutation.elements = curve_order(element_centroids(*this), ordering);
+    }
+  }
+
+  permute(permutation);
+  return permutation;
+}
+
+void Mesh::permute(const Permutation &permutation) {
+  /**
+   * @brief Reorder vertices and elements, and update elements connectivity
+   * and groups ids to the new order. Group members keep their order.
+   *
+   * @param permutation vertices and elements permutations, see Permutation.
+   * @throw std::runtime_error If a permutation does not match the mesh size.
+   */
+  auto n_elements = _elements.has_value() ? _elements->size() : 0;
+
+  if (!is_permutation(permutation.vertices, _vertices.size())) {
+    throw std::runtime_error(
+        "unvpp::Mesh::permute(): Invalid vertices permutation");
+  }
+  if (!is_permutation(permutation.elements, n_elements)) {
+    throw std::runtime_error(
+        "unvpp::Mesh::permute(): Invalid elements permutation");
+  }
+
+  auto new_vertex_ids = inverse(permutation.vertices);
+  auto new_element_ids = inverse(permutation.elements);
+
+  std::vector<std::array<double, 3>> vertices(_vertices.size());
+  parallel_for(vertices.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      vertices[i] = _vertices[permutation.vertices[i]];
+    }
+  });
+  _vertices = std::move(vertices);
+
+  if (_elements.has_value()) {
+    std::vector<Element> elements;
+    elements.reserve(n_elements);
+    for (auto e_id : permutation.elements) {
+      elements.push_back(std::move((*_elements)[e_id]));
+    }
+
+    parallel_for(n_elements, grain, [&](std::size_t begin, std::size_t end) {
+      for (auto e_id = begin; e_id < end; ++e_id) {
+        for (auto &v_id : elements[e_id].vertices_ids()) {
+          v_id = new_vertex_ids[v_id];
+        }
+      }
+    });
+    _elements = std::move(elements);
+  }
+
+  if (_groups.has_value()) {
+    for (auto &group : *_groups) {
+      const auto &new_ids = group.type() == GroupType::Vertex ? new_vertex_ids
+                                                              : new_element_ids;
+      GroupMembers ids;
+      for (auto id : group.elements_ids()) {
+        ids.push_back(new_ids[id]);
+      }
+      group.set_elements_ids(std::move(ids));
+    }
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,358 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/results.h>
+
+#include <array>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+#include <fast_float/fast_float.h>
+
+#include "parallel.h"
+#include "reader.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of records handled by one parallel chunk
+constexpr std::size_t grain = 2048;
+
+// maximum length of a number written in a fixed width UNV field
+constexpr std::size_t max_number_length = 64;
+
+template <typename Fn>
+void for_each_token(std::string_view line, Fn &&fn) {
+  /**
+   * @brief Call `fn` on each blank separated token of a line.
+   */
+  auto pos = line.find_first_not_of(' ');
+  while (pos != std::string_view::npos) {
+    auto end = line.find(' ', pos);
+    if (end == std::string_view::npos) {
+      end = line.size();
+    }
+    fn(line.substr(pos, end - pos));
+    pos = line.find_first_not_of(' ', end);
+  }
+}
+
+auto parse_integer(std::string_view token) -> std::int64_t {
+  std::int64_t number{};
+  auto [ptr, ec] =
+      std::from_chars(token.data(), token.data() + token.size(), number);
+  if (ec != std::errc() || ptr != token.data() + token.size()) {
+    throw std::runtime_error("unvpp::Reader::read_results(): Error parsing "
+                             "integer '" + std::string(token) + "'");
+  }
+  return number;
+}
+
+auto parse_double(std::string_view token) -> double {
+  /**
+   * @brief Parse a real, accepting Fortran D exponents.
+   */
+  double number{};
+  auto [ptr, ec] =
+      fast_float::from_chars(token.data(), token.data() + token.size(), number);
+  if (ec == std::errc() && ptr == token.data() + token.size()) {
+    return number;
+  }
+
+  if (token.size() <= max_number_length) {
+    std::array<char, max_number_length> buffer{};
+    for (std::size_t i = 0; i < token.size(); ++i) {
+      buffer[i] = token[i] == 'D' || token[i] == 'd' ? 'E' : token[i];
+    }
+    auto [end, error] =
+        fast_float::from_chars(buffer.data(), buffer.data() + token.size(),
+                               number);
+    if (error == std::errc() && end == buffer.data() + token.size()) {
+      return number;
+    }
+  }
+
+  throw std::runtime_error("unvpp::Reader::read_results(): Error parsing "
+                           "real '" + std::string(token) + "'");
+}
+
+auto trim(std::string_view line) -> std::string {
+  auto start = line.find_first_not_of(' ');
+  if (start == std::string_view::npos) {
+    return {};
+  }
+  auto end = line.find_last_not_of(' ');
+  return std::string(line.substr(start, end - start + 1));
+}
+
+/* Data records of a result dataset, stored as a single block of text */
+class DataLines {
+public:
+  void push_back(std::string_view line) {
+    _starts.push_back(_text.size());
+    _text.append(line);
+  }
+
+  auto size() const noexcept -> std::size_t { return _starts.size(); }
+
+  auto operator[](std::size_t i) const -> std::string_view {
+    auto end = i + 1 < _starts.size() ? _starts[i + 1] : _text.size();
+    return std::string_view(_text).substr(_starts[i], end - _starts[i]);
+  }
+
+private:
+  std::string _text;
+  std::vector<std::size_t> _starts;
+};
+
+/* Values of one entity, spanning one or more data lines */
+struct DataRecord {
+  std::size_t index;
+  std::size_t first_line;
+  std::size_t n_lines;
+  std::size_t n_values;
+};
+
+} // namespace
+
+void Reader::read_results(TagKind kind) {
+  /**
+   * @brief Read a results tag 2414 or 55.
+   *
+   * The data records are first read as text, then their entity ids are
+   * resolved sequentially and their values parsed in parallel into the
+   * dataset components.
+   *
+   * @param kind kind of the tag, TagKind::Results or TagKind::NodalData.
+   *
+   * @throw std::runtime_error If the stream does not contain a valid unv file
+   * or a record refers to an unknown vertex or element.
+   *
+   */
+  auto next_line = [this]() -> std::string_view {
+    if (!_stream.read_line(_temp_line) || is_separator(_temp_line)) {
+      throw std::runtime_error(
+          "unvpp::Reader::read_results(): Unexpected end of results tag at "
+          "line " + std::to_string(_stream.line_number()));
+    }
+    return _temp_line;
+  };
+
+  // read `n` integers (or reals) spanning one or more lines
+  auto read_integers = [&](std::size_t n) {
+    std::vector<std::int64_t> numbers;
+    while (numbers.size() < n) {
+      for_each_token(next_line(), [&](std::string_view token) {
+        numbers.push_back(parse_integer(token));
+      });
+    }
+    return numbers;
+  };
+
+  auto read_reals = [&](std::size_t n) {
+    std::vector<double> numbers;
+    while (numbers.size() < n) {
+      for_each_token(next_line(), [&](std::string_view token) {
+        numbers.push_back(parse_double(token));
+      });
+    }
+    return numbers;
+  };
+
+  ResultDataset dataset;
+  std::int64_t location = 1;
+  std::int64_t data_type = 0;
+  std::int64_t n_entity_values = 0;
+
+  if (kind == TagKind::Results) {
+    dataset.label = static_cast<std::size_t>(read_integers(1).at(0));
+    dataset.name = trim(next_line());
+    location = read_integers(1).at(0);
+
+    // five ID lines
+    for (std::size_t i = 0; i < 5; ++i) {
+      next_line();
+    }
+
+    auto header = read_integers(6);
+    dataset.analysis_type = header[1];
+    dataset.data_characteristic = header[2];
+    data_type = header[4];
+    n_entity_values = header[5];
+    dataset.is_complex = data_type == 5 || data_type == 6;
+
+    // integer data (8 + 2 values) and real data (6 + 6 values) records
+    dataset.integer_data = read_integers(8);
+    auto more_integers = read_integers(2);
+    dataset.integer_data.insert(dataset.integer_data.end(),
+                                more_integers.begin(), more_integers.end());
+    dataset.real_data = read_reals(6);
+    auto more_reals = read_reals(6);
+    dataset.real_data.insert(dataset.real_data.end(), more_reals.begin(),
+                             more_reals.end());
+  } else {
+    dataset.name = trim(next_line());
+    for (std::size_t i = 0; i < 4; ++i) {
+      next_line();
+    }
+
+    auto header = read_integers(6);
+    dataset.analysis_type = header[1];
+    dataset.data_characteristic = header[2];
+    data_type = header[4];
+    n_entity_values = header[5];
+    dataset.is_complex = data_type == 5;
+
+    // counts of analysis specific integers and reals, followed by integers
+    auto integers = read_integers(2);
+    auto n_integers = static_cast<std::size_t>(integers[0]);
+    auto n_reals = static_cast<std::size_t>(integers[1]);
+    while (integers.size() < n_integers + 2) {
+      for_each_token(next_line(), [&](std::string_view token) {
+        integers.push_back(parse_integer(token));
+      });
+    }
+    dataset.integer_data.assign(integers.begin() + 2, integers.end());
+    dataset.real_data = read_reals(n_reals);
+  }
+
+  // data at nodes on elements (3) and at points (5) are not supported
+  if (location != 1 && location != 2) {
+    skip_tag();
+    return;
+  }
+
+  dataset.location =
+      location == 1 ? ResultLocation::Vertices : ResultLocation::Elements;
+  const auto &ids_map = location == 1 ? _unv_vertex_id_to_ordered_id_map
+                                      : _unv_element_id_to_ordered_id_map;
+  auto n_entities = location == 1 ? _vertices.size() : _elements.size();
+  auto n_components = static_cast<std::size_t>(n_entity_values) *
+                      (dataset.is_complex ? 2 : 1);
+  auto has_values_count = kind == TagKind::Results && location == 2;
+
+  DataLines lines;
+  while (_stream.read_line(_temp_line) && !is_separator(_temp_line)) {
+    lines.push_back(_temp_line);
+  }
+
+  // records span as many lines as needed to hold their values, which may
+  // not fill their last line
+  std::vector<DataRecord> records;
+  for (std::size_t line = 0; line < lines.size();) {
+    std::vector<std::int64_t> header;
+    for_each_token(lines[line], [&](std::string_view token) {
+      header.push_back(parse_integer(token));
+    });
+    if (header.empty() || (has_values_count && header.size() < 2)) {
+      throw std::runtime_error(
+          "unvpp::Reader::read_results(): Invalid record header in results "
+          "dataset " + dataset.name);
+    }
+
+    auto n_values = has_values_count ? static_cast<std::size_t>(header[1])
+                                     : n_components;
+    std::size_t n_lines = 0;
+    for (std::size_t n_read = 0;
+         n_read < n_values && line + 1 + n_lines < lines.size(); ++n_lines) {
+      for_each_token(lines[line + 1 + n_lines],
+                     [&](std::string_view /*token*/) { ++n_read; });
+    }
+
+    auto unv_id = static_cast<std::size_t>(header[0]);
+    auto id = ids_map.find(unv_id);
+    if (!id.has_value()) {
+      throw std::runtime_error(
+          "unvpp::Reader::read_results(): Results dataset " + dataset.name +
+          " refers to unknown " + (location == 1 ? "vertex " : "element ") +
+          std::to_string(unv_id));
+    }
+
+    records.push_back(DataRecord{*id, line + 1, n_lines, n_values});
+    line += 1 + n_lines;
+  }
+
+  dataset.components.assign(
+      n_components,
+      std::vector<double>(n_entities, std::numeric_limits<double>::quiet_NaN()));
+
+  parallel_for(records.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto r = begin; r < end; ++r) {
+      const auto &record = records[r];
+      std::size_t value = 0;
+      for (auto line = record.first_line;
+           line < record.first_line + record.n_lines; ++line) {
+        for_each_token(lines[line], [&](std::string_view token) {
+          if (value < n_components) {
+            dataset.components[value][record.index] = parse_double(token);
+          }
+          ++value;
+        });
+      }
+
+      if (value < record.n_values) {
+        throw std::runtime_error(
+            "unvpp::Reader::read_results(): Missing values in results "
+            "dataset " + dataset.name);
+      }
+    }
+  });
+
+  _results_handler(std::move(dataset));
+}
+
+void stream_results(const std::filesystem::path &path,
+                    const std::function<void(ResultDataset &&)> &fn) {
+  /**
+   * @brief Read the result datasets of a UNV file one at a time.
+   *
+   * @param path path to the input UNV file
+   * @param fn callable invoked with each dataset, in file order
+   */
+  check_input_file(path);
+
+  auto reader = Reader(path);
+  reader.set_results_handler(fn);
+  reader.read_tags();
+}
+
+auto read_results(const std::filesystem::path &path)
+    -> std::vector<ResultDataset> {
+  /**
+   * @brief Read the result datasets of a UNV file.
+   *
+   * @param path path to the input UNV file
+   * @return std::vector<ResultDataset>
+   */
+  std::vector<ResultDataset> datasets;
+  stream_results(path, [&datasets](ResultDataset &&dataset) {
+    datasets.push_back(std::move(dataset));
+  });
+  return datasets;
+}
+
+} // namespace unvpp
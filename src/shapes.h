@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <unvpp/unvpp.h>
+
+namespace unvpp {
+
+using Point = std::array<double, 3>;
+
+inline auto subtract(const Point &a, const Point &b) -> Point {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+inline auto cross(const Point &a, const Point &b) -> Point {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+inline auto dot(const Point &a, const Point &b) -> double {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline auto norm(const Point &a) -> double { return std::sqrt(dot(a, a)); }
+
+template <std::size_t N>
+inline auto average(const std::array<Point, N> &points) -> Point {
+  Point sum{0., 0., 0.};
+  for (const auto &point : points) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      sum[axis] += point[axis];
+    }
+  }
+  for (auto &x : sum) {
+    x /= static_cast<double>(N);
+  }
+  return sum;
+}
+
+struct FaceGeometry {
+  Point centroid;
+  Point area_vector;
+};
+
+inline auto triangle_geometry(const Point &a, const Point &b, const Point &c)
+    -> FaceGeometry {
+  auto area_vector = cross(subtract(b, a), subtract(c, a));
+  for (auto &x : area_vector) {
+    x *= 0.5;
+  }
+  return {average(std::array<Point, 3>{a, b, c}), area_vector};
+}
+
+inline auto quad_geometry(const Point &a, const Point &b, const Point &c,
+                          const Point &d) -> FaceGeometry {
+  /**
+   * @brief Split the quad along its (a, c) diagonal, the centroid is the
+   * area weighted centroid of both triangles.
+   */
+  auto first = triangle_geometry(a, b, c);
+  auto second = triangle_geometry(a, c, d);
+  auto first_area = norm(first.area_vector);
+  auto second_area = norm(second.area_vector);
+  auto area = first_area + second_area;
+
+  FaceGeometry face{};
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    face.area_vector[axis] = first.area_vector[axis] + second.area_vector[axis];
+    face.centroid[axis] =
+        area > 0. ? (first_area * first.centroid[axis] +
+                     second_area * second.centroid[axis]) /
+                        area
+                  : 0.5 * (a[axis] + c[axis]);
+  }
+  return face;
+}
+
+/* Face of a cell as positions in its corners, triangles leave the last unused */
+struct LocalFace {
+  std::size_t n_corners;
+  std::array<std::size_t, 4> corners;
+};
+
+template <ElementType Type>
+constexpr auto cell_faces() {
+  /**
+   * @brief Faces of a cell type, as positions in the cell corners, ordered
+   * so that their normals point outward of a cell with positive volume.
+   */
+  if constexpr (Type == ElementType::Tetra) {
+    return std::array<LocalFace, 4>{{{3, {0, 2, 1, 0}},
+                                     {3, {0, 1, 3, 0}},
+                                     {3, {1, 2, 3, 0}},
+                                     {3, {0, 3, 2, 0}}}};
+  } else if constexpr (Type == ElementType::Wedge) {
+    return std::array<LocalFace, 5>{{{3, {0, 2, 1, 0}},
+                                     {3, {3, 4, 5, 0}},
+                                     {4, {0, 1, 4, 3}},
+                                     {4, {1, 2, 5, 4}},
+                                     {4, {2, 0, 3, 5}}}};
+  } else {
+    static_assert(Type == ElementType::Hex, "Type must be a cell type");
+    return std::array<LocalFace, 6>{{{4, {0, 3, 2, 1}},
+                                     {4, {4, 5, 6, 7}},
+                                     {4, {0, 1, 5, 4}},
+                                     {4, {1, 2, 6, 5}},
+                                     {4, {2, 3, 7, 6}},
+                                     {4, {3, 0, 4, 7}}}};
+  }
+}
+
+template <ElementType Type>
+constexpr auto element_edges() {
+  /**
+   * @brief Edges of an element type, as pairs of positions in its corners.
+   */
+  using Edge = std::array<std::size_t, 2>;
+  if constexpr (Type == ElementType::Line) {
+    return std::array<Edge, 1>{{{0, 1}}};
+  } else if constexpr (Type == ElementType::Triangle) {
+    return std::array<Edge, 3>{{{0, 1}, {1, 2}, {2, 0}}};
+  } else if constexpr (Type == ElementType::Quad) {
+    return std::array<Edge, 4>{{{0, 1}, {1, 2}, {2, 3}, {3, 0}}};
+  } else if constexpr (Type == ElementType::Tetra) {
+    return std::array<Edge, 6>{
+        {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}}};
+  } else if constexpr (Type == ElementType::Wedge) {
+    return std::array<Edge, 9>{{{0, 1},
+                                {1, 2},
+                                {2, 0},
+                                {3, 4},
+                                {4, 5},
+                                {5, 3},
+                                {0, 3},
+                                {1, 4},
+                                {2, 5}}};
+  } else {
+    return std::array<Edge, 12>{{{0, 1},
+                                 {1, 2},
+                                 {2, 3},
+                                 {3, 0},
+                                 {4, 5},
+                                 {5, 6},
+                                 {6, 7},
+                                 {7, 4},
+                                 {0, 4},
+                                 {1, 5},
+                                 {2, 6},
+                                 {3, 7}}};
+  }
+}
+
+template <ElementType Type>
+constexpr auto corner_neighbours() {
+  /**
+   * @brief For each corner of a cell type, the three corners it shares an
+   * edge with, ordered so that their edges form a direct frame in a cell
+   * with positive volume.
+   */
+  using Corner = std::array<std::size_t, 3>;
+  if constexpr (Type == ElementType::Tetra) {
+    return std::array<Corner, 4>{{{1, 2, 3}, {2, 0, 3}, {0, 1, 3}, {2, 1, 0}}};
+  } else if constexpr (Type == ElementType::Wedge) {
+    return std::array<Corner, 6>{{{1, 2, 3},
+                                  {2, 0, 4},
+                                  {0, 1, 5},
+                                  {5, 4, 0},
+                                  {3, 5, 1},
+                                  {4, 3, 2}}};
+  } else {
+    static_assert(Type == ElementType::Hex, "Type must be a cell type");
+    return std::array<Corner, 8>{{{1, 3, 4},
+                                  {2, 0, 5},
+                                  {3, 1, 6},
+                                  {0, 2, 7},
+                                  {7, 5, 0},
+                                  {4, 6, 1},
+                                  {5, 7, 2},
+                                  {6, 4, 3}}};
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,477 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/spatial.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "common.h"
+#include "parallel.h"
+
+namespace unvpp {
+
+namespace {
+
+using Point = std::array<double, 3>;
+
+// maximum number of items stored in a leaf node
+constexpr std::size_t leaf_size = 8;
+
+// number of queries (or items) handled by one parallel chunk
+constexpr std::size_t query_grain = 1024;
+
+// decomposition of volume cells into tetrahedra, in corner indices
+constexpr std::array<std::array<std::size_t, 4>, 1> tetra_tets{{{0, 1, 2, 3}}};
+constexpr std::array<std::array<std::size_t, 4>, 3> wedge_tets{
+    {{0, 1, 2, 3}, {1, 2, 5, 3}, {1, 4, 5, 3}}};
+constexpr std::array<std::array<std::size_t, 4>, 6> hex_tets{{{0, 6, 1, 2},
+                                                              {0, 6, 2, 3},
+                                                              {0, 6, 3, 7},
+                                                              {0, 6, 7, 4},
+                                                              {0, 6, 4, 5},
+                                                              {0, 6, 5, 1}}};
+
+// barycentric coordinates tolerance for points lying on cell faces
+constexpr double containment_tolerance = 1e-10;
+
+auto inline sub(const Point &a, const Point &b) -> Point {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+auto inline det(const Point &a, const Point &b, const Point &c) -> double {
+  return a[0] * (b[1] * c[2] - b[2] * c[1]) -
+         a[1] * (b[0] * c[2] - b[2] * c[0]) +
+         a[2] * (b[0] * c[1] - b[1] * c[0]);
+}
+
+auto inline squared_distance(const Point &a, const Point &b) -> double {
+  auto d = sub(a, b);
+  return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+}
+
+auto inline squared_box_distance(const Point &point, const Point &lower,
+                                 const Point &upper) -> double {
+  double distance = 0.;
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    auto outside = std::max({lower[axis] - point[axis], 0.,
+                             point[axis] - upper[axis]});
+    distance += outside * outside;
+  }
+  return distance;
+}
+
+auto inline box_contains(const Point &point, const Point &lower,
+                         const Point &upper) -> bool {
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    if (point[axis] < lower[axis] || point[axis] > upper[axis]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto tetra_contains(const Point &a, const Point &b, const Point &c,
+                    const Point &d, const Point &point) -> bool {
+  /**
+   * @brief Check if a point lies inside (or on the boundary of) a tetrahedron
+   * using its barycentric coordinates, regardless of the tetrahedron
+   * orientation.
+   */
+  auto ab = sub(b, a);
+  auto ac = sub(c, a);
+  auto ad = sub(d, a);
+  auto ap = sub(point, a);
+
+  auto volume = det(ab, ac, ad);
+  if (volume == 0.) {
+    return false;
+  }
+
+  auto l1 = det(ap, ac, ad) / volume;
+  auto l2 = det(ab, ap, ad) / volume;
+  auto l3 = det(ab, ac, ap) / volume;
+  auto l0 = 1. - l1 - l2 - l3;
+
+  return l0 >= -containment_tolerance && l1 >= -containment_tolerance &&
+         l2 >= -containment_tolerance && l3 >= -containment_tolerance;
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex(const Mesh &mesh) : _mesh(&mesh) {
+  const auto &vertices = mesh.vertices();
+  _vertices_tree = build_tree(vertices, vertices);
+
+  if (!mesh.elements().has_value()) {
+    return;
+  }
+
+  const auto &elements = mesh.elements().value();
+  for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+    if (is_volume_type(elements[e_id].type())) {
+      _cells_ids.push_back(e_id);
+    }
+  }
+
+  std::vector<Point> lower(_cells_ids.size());
+  std::vector<Point> upper(_cells_ids.size());
+
+  parallel_for(_cells_ids.size(), query_grain,
+               [&](std::size_t begin, std::size_t end) {
+                 for (auto i = begin; i < end; ++i) {
+                   const auto &ids = elements[_cells_ids[i]].vertices_ids();
+                   lower[i] = vertices[ids.front()];
+                   upper[i] = vertices[ids.front()];
+                   for (auto v_id : ids) {
+                     for (std::size_t axis = 0; axis < 3; ++axis) {
+                       lower[i][axis] =
+                           std::min(lower[i][axis], vertices[v_id][axis]);
+                       upper[i][axis] =
+                           std::max(upper[i][axis], vertices[v_id][axis]);
+                     }
+                   }
+                 }
+               });
+
+  _cells_tree = build_tree(lower, upper);
+}
+
+auto SpatialIndex::build_tree(const std::vector<Point> &lower,
+                              const std::vector<Point> &upper) -> Tree {
+  /**
+   * @brief Build a bounding volume hierarchy over a set of boxes.
+   *
+   * Nodes are split at the median of the box centers along the widest axis.
+   * The tree is built level by level, splitting all nodes of a level in
+   * parallel, and children are numbered in level order afterwards, which
+   * makes the tree layout independent of the number of threads.
+   *
+   * @param lower lower corners of the boxes
+   * @param upper upper corners of the boxes
+   * @return Tree The hierarchy, with items indexing the input boxes.
+   */
+  Tree tree;
+  auto n_items = lower.size();
+  if (n_items == 0) {
+    return tree;
+  }
+
+  tree.items.resize(n_items);
+  std::iota(tree.items.begin(), tree.items.end(), 0);
+
+  auto center = [&](std::size_t item, std::size_t axis) {
+    return 0.5 * (lower[item][axis] + upper[item][axis]);
+  };
+
+  tree.nodes.push_back(Node{{}, {}, 0, n_items});
+  std::vector<std::size_t> level{0};
+  std::vector<char> is_split;
+
+  while (!level.empty()) {
+    is_split.assign(level.size(), 0);
+
+    parallel_for(level.size(), 1, [&](std::size_t begin, std::size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        auto &node = tree.nodes[level[i]];
+        auto first = tree.items.begin() + node.offset;
+        auto last = first + node.count;
+
+        node.lower = lower[*first];
+        node.upper = upper[*first];
+        Point center_lower{center(*first, 0), center(*first, 1),
+                           center(*first, 2)};
+        Point center_upper = center_lower;
+
+        for (auto item = first; item != last; ++item) {
+          for (std::size_t axis = 0; axis < 3; ++axis) {
+            node.lower[axis] = std::min(node.lower[axis], lower[*item][axis]);
+            node.upper[axis] = std::max(node.upper[axis], upper[*item][axis]);
+            center_lower[axis] =
+                std::min(center_lower[axis], center(*item, axis));
+            center_upper[axis] =
+                std::max(center_upper[axis], center(*item, axis));
+          }
+        }
+
+        if (node.count <= leaf_size) {
+          continue;
+        }
+
+        std::size_t axis = 0;
+        for (std::size_t a = 1; a < 3; ++a) {
+          if (center_upper[a] - center_lower[a] >
+              center_upper[axis] - center_lower[axis]) {
+            axis = a;
+          }
+        }
+
+        std::nth_element(first, first + node.count / 2, last,
+                         [&](std::size_t lhs, std::size_t rhs) {
+                           auto c_lhs = center(lhs, axis);
+                           auto c_rhs = center(rhs, axis);
+                           return c_lhs < c_rhs || (c_lhs == c_rhs && lhs < rhs);
+                         });
+        is_split[i] = 1;
+      }
+    });
+
+    std::vector<std::size_t> next_level;
+    for (std::size_t i = 0; i < level.size(); ++i) {
+      if (is_split[i] == 0) {
+        continue;
+      }
+
+      auto first = tree.nodes[level[i]].offset;
+      auto count = tree.nodes[level[i]].count;
+      auto left = tree.nodes.size();
+
+      tree.nodes.push_back(Node{{}, {}, first, count / 2});
+      tree.nodes.push_back(Node{{}, {}, first + count / 2, count - count / 2});
+      tree.nodes[level[i]].offset = left;
+      tree.nodes[level[i]].count = 0;
+
+      next_level.push_back(left);
+      next_level.push_back(left + 1);
+    }
+    level = std::move(next_level);
+  }
+
+  return tree;
+}
+
+auto SpatialIndex::nearest_vertex(const Point &point) const -> std::size_t {
+  /**
+   * @brief Find the vertex closest to a point.
+   *
+   * @param point query point
+   * @return std::size_t Index of the closest vertex.
+   * @throw std::runtime_error If the mesh has no vertices.
+   */
+  auto nearest = nearest_vertices(point, 1);
+  if (nearest.empty()) {
+    throw std::runtime_error(
+        "unvpp::SpatialIndex::nearest_vertex(): Mesh has no vertices");
+  }
+  return nearest.front();
+}
+
+auto SpatialIndex::nearest_vertices(const Point &point, std::size_t k) const
+    -> std::vector<std::size_t> {
+  /**
+   * @brief Find the k vertices closest to a point.
+   *
+   * @param point query point
+   * @param k number of vertices to find
+   * @return std::vector<std::size_t> Indices of the min(k, vertices count)
+   * closest vertices, sorted by increasing distance (ties broken by index).
+   */
+  const auto &vertices = _mesh->vertices();
+  k = std::min(k, vertices.size());
+
+  // max-heap of the best candidates found so far
+  std::vector<std::pair<double, std::size_t>> best;
+  best.reserve(k + 1);
+
+  if (k == 0) {
+    return {};
+  }
+
+  std::vector<std::size_t> stack{0};
+  while (!stack.empty()) {
+    const auto &node = _vertices_tree.nodes[stack.back()];
+    stack.pop_back();
+
+    if (best.size() == k &&
+        squared_box_distance(point, node.lower, node.upper) >
+            best.front().first) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      const auto &left = _vertices_tree.nodes[node.offset];
+      const auto &right = _vertices_tree.nodes[node.offset + 1];
+
+      // visit the closer child first
+      if (squared_box_distance(point, left.lower, left.upper) <
+          squared_box_distance(point, right.lower, right.upper)) {
+        stack.push_back(node.offset + 1);
+        stack.push_back(node.offset);
+      } else {
+        stack.push_back(node.offset);
+        stack.push_back(node.offset + 1);
+      }
+      continue;
+    }
+
+    for (auto i = node.offset; i < node.offset + node.count; ++i) {
+      auto v_id = _vertices_tree.items[i];
+      auto candidate = std::make_pair(squared_distance(point, vertices[v_id]), v_id);
+
+      if (best.size() < k) {
+        best.push_back(candidate);
+        std::push_heap(best.begin(), best.end());
+      } else if (candidate < best.front()) {
+        std::pop_heap(best.begin(), best.end());
+        best.back() = candidate;
+        std::push_heap(best.begin(), best.end());
+      }
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end());
+
+  std::vector<std::size_t> nearest;
+  nearest.reserve(best.size());
+  for (const auto &candidate : best) {
+    nearest.push_back(candidate.second);
+  }
+  return nearest;
+}
+
+auto SpatialIndex::nearest_vertices(const std::vector<Point> &points,
+                                    std::size_t k) const
+    -> std::vector<std::size_t> {
+  /**
+   * @brief Find the k vertices closest to each point of a batch, in parallel.
+   *
+   * @param points query points
+   * @param k number of vertices to find for each point
+   * @return std::vector<std::size_t> Row-major array of points.size() rows
+   * of min(k, vertices count) vertex indices, see nearest_vertices().
+   */
+  k = std::min(k, _mesh->vertices().size());
+  std::vector<std::size_t> nearest(points.size() * k);
+
+  parallel_for(points.size(), query_grain,
+               [&](std::size_t begin, std::size_t end) {
+                 for (auto i = begin; i < end; ++i) {
+                   auto point_nearest = nearest_vertices(points[i], k);
+                   std::copy(point_nearest.begin(), point_nearest.end(),
+                             nearest.begin() + i * k);
+                 }
+               });
+
+  return nearest;
+}
+
+auto SpatialIndex::locate(const Point &point) const
+    -> std::optional<std::size_t> {
+  /**
+   * @brief Find the volume element containing a point.
+   *
+   * Hex and Wedge elements are split into tetrahedra for the inclusion test,
+   * which is exact for cells with planar faces. Points on a face shared by two
+   * cells are reported in one of them.
+   *
+   * @param point query point
+   * @return std::optional<std::size_t> Index of the containing element, or
+   * std::nullopt if the point lies outside the mesh volume elements.
+   */
+  if (_cells_tree.nodes.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::size_t> stack{0};
+  while (!stack.empty()) {
+    const auto &node = _cells_tree.nodes[stack.back()];
+    stack.pop_back();
+
+    if (!box_contains(point, node.lower, node.upper)) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      stack.push_back(node.offset + 1);
+      stack.push_back(node.offset);
+      continue;
+    }
+
+    for (auto i = node.offset; i < node.offset + node.count; ++i) {
+      auto e_id = _cells_ids[_cells_tree.items[i]];
+      if (cell_contains(e_id, point)) {
+        return e_id;
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+auto SpatialIndex::locate(const std::vector<Point> &points) const
+    -> std::vector<std::optional<std::size_t>> {
+  /**
+   * @brief Find the volume element containing each point of a batch, in
+   * parallel, see locate().
+   *
+   * @param points query points
+   * @return std::vector<std::optional<std::size_t>> Containing element of
+   * each point.
+   */
+  std::vector<std::optional<std::size_t>> cells(points.size());
+
+  parallel_for(points.size(), query_grain,
+               [&](std::size_t begin, std::size_t end) {
+                 for (auto i = begin; i < end; ++i) {
+                   cells[i] = locate(points[i]);
+                 }
+               });
+
+  return cells;
+}
+
+auto SpatialIndex::cell_contains(std::size_t element_id,
+                                 const Point &point) const -> bool {
+  const auto &vertices = _mesh->vertices();
+  const auto &element = _mesh->elements().value()[element_id];
+  const auto &ids = element.vertices_ids();
+
+  auto corner = [&](std::size_t c) -> const Point & {
+    return vertices[ids[corner_position(element.type(), ids.size(), c)]];
+  };
+
+  auto contains = [&](const auto &tets) {
+    return std::any_of(tets.begin(), tets.end(), [&](const auto &tet) {
+      return tetra_contains(corner(tet[0]), corner(tet[1]), corner(tet[2]),
+                            corner(tet[3]), point);
+    });
+  };
+
+  switch (element.type()) {
+  case ElementType::Tetra:
+    return contains(tetra_tets);
+  case ElementType::Wedge:
+    return contains(wedge_tets);
+  case ElementType::Hex:
+    return contains(hex_tets);
+  default:
+    return false;
+  }
+}
+
+} // namespace unvpp
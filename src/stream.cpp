@@ -24,6 +24,12 @@ SOFTWARE.
 
 #include "stream.h"
 
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "common.h"
+
 namespace unvpp {
 
 FileStream::FileStream(const std::filesystem::path &path)
@@ -38,6 +44,106 @@ auto FileStream::read_line(std::string &line) -> bool {
   return false;
 }
 
+void FileStream::skip_dataset(std::string *content) {
+  /**
+   * @brief Move past the separator line ending the current dataset.
+   *
+   * The file is read in raw blocks scanned for line breaks, and only the
+   * first characters of each line are compared to the separator, so lines
+   * are neither split nor copied. At the end of the file, the stream is
+   * left at end of file.
+   *
+   * @param content if given, the dataset lines before the separator are
+   * appended to it as they are in the file, line breaks included
+   */
+  constexpr std::size_t block_size = std::size_t{1} << 16;
+  constexpr auto prefix_size = SEPARATOR.size();
+
+  if (!_file_stream.good()) {
+    return;
+  }
+
+  _block.resize(block_size);
+  auto start = _file_stream.tellg();
+  auto content_start = content != nullptr ? content->size() : 0;
+
+  // offsets from start of the current block and of the current line
+  std::size_t offset{0};
+  std::size_t line_start{0};
+
+  // first characters of the current line, which may span blocks
+  std::array<char, prefix_size> prefix{};
+  std::size_t column{0};
+
+  auto is_separator_line = [&]() {
+    return column == prefix_size &&
+           std::string_view(prefix.data(), prefix_size) == SEPARATOR;
+  };
+
+  while (true) {
+    _file_stream.read(_block.data(), static_cast<std::streamsize>(block_size));
+    auto n_read = static_cast<std::size_t>(_file_stream.gcount());
+    if (n_read == 0) {
+      break;
+    }
+
+    if (content != nullptr) {
+      content->append(_block.data(), n_read);
+    }
+
+    std::size_t i = 0;
+    while (i < n_read) {
+      while (column < prefix_size && i < n_read && _block[i] != '\n') {
+        prefix[column++] = _block[i++];
+      }
+
+      const auto *line_end = static_cast<const char *>(
+          std::memchr(_block.data() + i, '\n', n_read - i));
+      if (line_end == nullptr) {
+        break;
+      }
+
+      auto end = static_cast<std::size_t>(line_end - _block.data());
+      ++_line_number;
+      if (is_separator_line()) {
+        if (content != nullptr) {
+          content->resize(content_start + line_start);
+        }
+        seek(start + static_cast<std::streamoff>(offset + end + 1),
+             _line_number);
+        return;
+      }
+
+      column = 0;
+      i = end + 1;
+      line_start = offset + i;
+    }
+
+    offset += n_read;
+  }
+
+  // last line of the file, without a line break
+  if (offset > line_start) {
+    ++_line_number;
+    if (content != nullptr && is_separator_line()) {
+      content->resize(content_start + line_start);
+    }
+  }
+  _file_stream.clear();
+  _file_stream.seekg(0, std::ios::end);
+  _file_stream.setstate(std::ios::eofbit);
+}
+
+auto FileStream::position() -> std::streampos {
+  return _file_stream.tellg();
+}
+
+void FileStream::seek(std::streampos position, std::size_t line_number) {
+  _file_stream.clear();
+  _file_stream.seekg(position);
+  _line_number = line_number;
+}
+
 FileStream::~FileStream() { _file_stream.close(); }
 
 } // namespace unvpp
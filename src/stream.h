@@ -27,6 +27,7 @@ SOFTWARE.
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace unvpp {
 class FileStream {
@@ -43,10 +44,14 @@ public:
   ~FileStream();
 
   auto read_line(std::string &line) -> bool;
+  void skip_dataset(std::string *content = nullptr);
+  auto position() -> std::streampos;
+  void seek(std::streampos position, std::size_t line_number);
 
 private:
   std::size_t _line_number{0};
   std::ifstream _file_stream;
+  std::vector<char> _block;
 };
 
 } // namespace unvpp
@@ -0,0 +1,188 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "topology.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of vertices handled by one parallel chunk
+constexpr std::size_t vertices_grain = 4096;
+
+auto is_corner(const Element &element, std::size_t v_id) -> bool {
+  /**
+   * @brief Check if a vertex is a corner of an element, not a mid-side
+   * vertex.
+   */
+  const auto &ids = element.vertices_ids();
+  for (std::size_t c = 0; c < corners_count(element.type()); ++c) {
+    if (ids[corner_position(element.type(), ids.size(), c)] == v_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+auto vertex_elements(const Mesh &mesh) -> Adjacency {
+  /**
+   * @brief Build the list of elements using each vertex.
+   *
+   * @param mesh input mesh
+   * @return Adjacency Elements of each vertex, in increasing order.
+   */
+  Adjacency adjacency;
+  adjacency.offsets.assign(mesh.vertices().size() + 1, 0);
+
+  if (!mesh.elements().has_value()) {
+    return adjacency;
+  }
+
+  const auto &elements = mesh.elements().value();
+  for (const auto &element : elements) {
+    for (auto v_id : element.vertices_ids()) {
+      ++adjacency.offsets[v_id + 1];
+    }
+  }
+
+  for (std::size_t v_id = 0; v_id < mesh.vertices().size(); ++v_id) {
+    adjacency.offsets[v_id + 1] += adjacency.offsets[v_id];
+  }
+
+  adjacency.ids.resize(adjacency.offsets.back());
+  auto cursor = adjacency.offsets;
+
+  for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+    for (auto v_id : elements[e_id].vertices_ids()) {
+      adjacency.ids[cursor[v_id]++] = e_id;
+    }
+  }
+
+  return adjacency;
+}
+
+auto vertex_neighbours(const Mesh &mesh) -> Adjacency {
+  /**
+   * @brief Build the vertex graph of a mesh, where two vertices are
+   * neighbours if they belong to the same element.
+   *
+   * @param mesh input mesh
+   * @return Adjacency Neighbours of each vertex, in increasing order.
+   */
+  auto n_vertices = mesh.vertices().size();
+
+  if (!mesh.elements().has_value()) {
+    return build_adjacency(n_vertices, vertices_grain,
+                           [](std::size_t, std::vector<std::size_t> &) {});
+  }
+
+  const auto &elements = mesh.elements().value();
+  auto elements_of = vertex_elements(mesh);
+
+  return build_adjacency(
+      n_vertices, vertices_grain,
+      [&](std::size_t v_id, std::vector<std::size_t> &ids) {
+        auto first = ids.size();
+        for (auto i = elements_of.offsets[v_id];
+             i < elements_of.offsets[v_id + 1]; ++i) {
+          for (auto n_id : elements[elements_of.ids[i]].vertices_ids()) {
+            if (n_id != v_id) {
+              ids.push_back(n_id);
+            }
+          }
+        }
+        std::sort(ids.begin() + first, ids.end());
+        ids.erase(std::unique(ids.begin() + first, ids.end()), ids.end());
+      });
+}
+
+auto dual_graph(const Mesh &mesh,
+                const Adjacency &elements_of,
+                const std::vector<std::size_t> &cells,
+                std::size_t min_shared) -> Adjacency {
+  /**
+   * @brief Build the dual graph of a set of cells, where two cells are
+   * neighbours if they share at least `min_shared` corner vertices (a face
+   * for volume cells when `min_shared` is 3).
+   *
+   * @param mesh input mesh
+   * @param elements_of elements of each vertex, see vertex_elements()
+   * @param cells elements ids of the graph nodes
+   * @param min_shared number of shared corners making two cells neighbours
+   * @return Adjacency Neighbours of each cell, as positions in `cells`.
+   */
+  constexpr auto not_a_cell = std::numeric_limits<std::size_t>::max();
+  const auto &elements = mesh.elements().value();
+
+  std::vector<std::size_t> position(elements.size(), not_a_cell);
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    position[cells[i]] = i;
+  }
+
+  return build_adjacency(
+      cells.size(), vertices_grain,
+      [&](std::size_t i, std::vector<std::size_t> &ids) {
+        // candidates are collected at the end of `ids`, then compacted
+        // only corners are counted, since parabolic elements sharing an
+        // edge also share its mid-side vertex
+        auto first = ids.size();
+        const auto &element = elements[cells[i]];
+        const auto &vertices_ids = element.vertices_ids();
+        for (std::size_t c = 0; c < corners_count(element.type()); ++c) {
+          auto v_id = vertices_ids[corner_position(element.type(),
+                                                   vertices_ids.size(), c)];
+          for (auto j = elements_of.offsets[v_id];
+               j < elements_of.offsets[v_id + 1]; ++j) {
+            auto other = position[elements_of.ids[j]];
+            if (other != not_a_cell && other != i &&
+                is_corner(elements[elements_of.ids[j]], v_id)) {
+              ids.push_back(other);
+            }
+          }
+        }
+        std::sort(ids.begin() + first, ids.end());
+
+        auto last = first;
+        for (auto j = first; j < ids.size();) {
+          auto k = j;
+          while (k < ids.size() && ids[k] == ids[j]) {
+            ++k;
+          }
+          if (k - j >= min_shared) {
+            ids[last++] = ids[j];
+          }
+          j = k;
+        }
+        ids.resize(last);
+      });
+}
+
+} // namespace unvpp
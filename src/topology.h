@@ -0,0 +1,97 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <unvpp/unvpp.h>
+
+#include "parallel.h"
+
+namespace unvpp {
+
+/* Compressed sparse row adjacency lists */
+struct Adjacency {
+  /**
+   * @brief Neighbours of item i are ids[offsets[i]] to ids[offsets[i + 1]].
+   */
+  std::vector<std::size_t> offsets;
+  std::vector<std::size_t> ids;
+
+  auto degree(std::size_t i) const -> std::size_t {
+    return offsets[i + 1] - offsets[i];
+  }
+};
+
+template <typename Fn>
+auto build_adjacency(std::size_t n, std::size_t grain, Fn &&fn) -> Adjacency {
+  /**
+   * @brief Build adjacency lists in parallel, where `fn(i, ids)` appends the
+   * neighbours of item i to `ids`. Each chunk of items fills its own buffer,
+   * and buffers are concatenated in chunk order.
+   *
+   * @param n number of items
+   * @param grain number of items per parallel chunk
+   * @param fn callable invoked as fn(i, std::vector<std::size_t> &ids)
+   * @return Adjacency
+   */
+  Adjacency adjacency;
+  adjacency.offsets.assign(n + 1, 0);
+  std::vector<std::vector<std::size_t>> chunks_ids(chunks_count(n, grain));
+
+  parallel_for_chunks(
+      n, grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &ids = chunks_ids[chunk];
+        for (auto i = begin; i < end; ++i) {
+          auto first = ids.size();
+          fn(i, ids);
+          adjacency.offsets[i + 1] = ids.size() - first;
+        }
+      });
+
+  for (std::size_t i = 0; i < n; ++i) {
+    adjacency.offsets[i + 1] += adjacency.offsets[i];
+  }
+
+  adjacency.ids.resize(adjacency.offsets.back());
+  parallel_for_chunks(
+      n, grain, [&](std::size_t chunk, std::size_t begin, std::size_t /*end*/) {
+        std::copy(chunks_ids[chunk].begin(), chunks_ids[chunk].end(),
+                  adjacency.ids.begin() + adjacency.offsets[begin]);
+        chunks_ids[chunk] = {};
+      });
+
+  return adjacency;
+}
+
+auto vertex_elements(const Mesh &mesh) -> Adjacency;
+auto vertex_neighbours(const Mesh &mesh) -> Adjacency;
+auto dual_graph(const Mesh &mesh,
+                const Adjacency &elements_of,
+                const std::vector<std::size_t> &cells,
+                std::size_t min_shared) -> Adjacency;
+
+} // namespace unvpp
@@ -25,6 +25,7 @@ SOFTWARE.
 
 #include <stdexcept>
 
+#include "placement.h"
 #include "reader.h"
 #include "stream.h"
 
@@ -51,12 +52,13 @@ auto is_crlf_and_not_windows(const std::filesystem::path &path) -> bool {
   return false;
 }
 
-auto read(const std::filesystem::path &path) -> Mesh {
+void check_input_file(const std::filesystem::path &path) {
   /**
-   * @brief Read an input UNV mesh file.
+   * @brief Check that the input file exists, is a regular file and has line
+   * endings supported by the platform.
    *
-   * @param path path to the input UNV mesh file
-   * @return Mesh
+   * @param path path to the input file
+   * @throw std::runtime_error If the input file cannot be read.
    */
   if (!std::filesystem::exists(path)) {
     throw std::runtime_error("Input UNV mesh file does not exist!");
@@ -71,12 +73,81 @@ auto read(const std::filesystem::path &path) -> Mesh {
     throw std::runtime_error("Input UNV mesh file has Windows line endings, "
                              "please convert to UNIX line endings.");
   }
+}
+
+auto read(const std::filesystem::path &path) -> Mesh {
+  /**
+   * @brief Read an input UNV mesh file.
+   *
+   * @param path path to the input UNV mesh file
+   * @return Mesh
+   */
+  return read(path, ReadOptions());
+}
+
+auto read(const std::filesystem::path &path, const ReadOptions &options)
+    -> Mesh {
+  /**
+   * @brief Read an input UNV mesh file, running parallel loops on the
+   * executor, passing other datasets to the handlers, validating records,
+   * transforming vertices and placing the mesh arrays in memory as set in the
+   * options.
+   *
+   * @param path path to the input UNV mesh file
+   * @param options read options
+   * @return Mesh
+   */
+  auto &executor = options.executor != nullptr ? *options.executor
+                                               : current_executor();
+  ExecutorScope scope(executor);
+
+  check_input_file(path);
 
   auto reader = Reader(path);
+  reader.set_dataset_handlers(options.datasets);
+  reader.set_validation(options.validation);
+  reader.set_vertices_transform(options.si_units, options.coordinate_systems);
+  reader.set_memory_placement(options.placement);
+  reader.read_tags();
+  if (options.si_units || options.coordinate_systems) {
+    reader.transform_vertices();
+  }
+  if (options.placement == MemoryPlacement::FirstTouch) {
+    place_connectivity(reader.elements());
+  }
+
+  // the reader arrays are moved, so the mesh is never held twice
+  return Mesh{std::move(reader.vertices()), std::move(reader.elements()),
+              std::move(reader.groups()), reader.units()};
+}
+
+auto read_partition(const std::filesystem::path &path, std::size_t rank,
+                    std::size_t n_ranks) -> MeshSlice {
+  /**
+   * @brief Read the share of an input UNV mesh file owned by a rank.
+   *
+   * @param path path to the input UNV mesh file
+   * @param rank index of the slice to read
+   * @param n_ranks number of slices
+   * @return MeshSlice
+   */
+  if (n_ranks == 0 || rank >= n_ranks) {
+    throw std::runtime_error("unvpp::read_partition(): Invalid rank " +
+                             std::to_string(rank) + " of " +
+                             std::to_string(n_ranks) + " ranks");
+  }
+
+  check_input_file(path);
+
+  auto reader = Reader(path, Slice{rank, n_ranks});
   reader.read_tags();
 
-  return Mesh{reader.vertices(), reader.elements(), reader.groups(),
-              reader.units()};
+  return MeshSlice{std::move(reader.vertices_unv_ids()),
+                   std::move(reader.vertices()),
+                   std::move(reader.elements_unv_ids()),
+                   std::move(reader.elements()),
+                   std::move(reader.groups()),
+                   reader.units()};
 }
 
 } // namespace unvpp
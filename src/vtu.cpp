@@ -0,0 +1,474 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <unvpp/vtu.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef UNVPP_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "parallel.h"
+
+namespace unvpp {
+
+namespace {
+
+// size of the blocks arrays are split into, a multiple of all items sizes
+constexpr std::size_t block_size = std::size_t{1} << 20;
+
+// number of elements handled by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+// width reserved for the offsets of arrays in the XML header
+constexpr std::size_t offset_width = 20;
+
+/* VTK cell type, and position in the UNV element of each VTK vertex */
+struct VtkCell {
+  std::uint8_t type;
+  const std::size_t *order;
+};
+
+auto vtk_cell(ElementType type, std::size_t n_vertices) -> VtkCell {
+  /**
+   * @brief VTK cell of a UNV element, nullptr order for the same ordering.
+   *
+   * UNV parabolic elements interleave corners and mid-side vertices, VTK
+   * quadratic cells list corners first. VTK wedges orient their first
+   * triangle away from the second, UNV wedges towards it.
+   */
+  static constexpr std::array<std::size_t, 3> line3{0, 2, 1};
+  static constexpr std::array<std::size_t, 6> triangle6{0, 2, 4, 1, 3, 5};
+  static constexpr std::array<std::size_t, 8> quad8{0, 2, 4, 6, 1, 3, 5, 7};
+  static constexpr std::array<std::size_t, 10> tetra10{0, 2, 4, 9, 1,
+                                                       3, 5, 6, 7, 8};
+  static constexpr std::array<std::size_t, 6> wedge6{0, 2, 1, 3, 5, 4};
+  static constexpr std::array<std::size_t, 15> wedge15{
+      0, 4, 2, 9, 13, 11, 5, 3, 1, 14, 12, 10, 6, 8, 7};
+  static constexpr std::array<std::size_t, 20> hex20{
+      0, 2, 4, 6, 12, 14, 16, 18, 1, 3, 5, 7, 13, 15, 17, 19, 8, 9, 10, 11};
+
+  switch (type) {
+  case ElementType::Line:
+    if (n_vertices == 2) {
+      return {3, nullptr};
+    }
+    if (n_vertices == 3) {
+      return {21, line3.data()};
+    }
+    break;
+  case ElementType::Triangle:
+    if (n_vertices == 3) {
+      return {5, nullptr};
+    }
+    if (n_vertices == 6) {
+      return {22, triangle6.data()};
+    }
+    break;
+  case ElementType::Quad:
+    if (n_vertices == 4) {
+      return {9, nullptr};
+    }
+    if (n_vertices == 8) {
+      return {23, quad8.data()};
+    }
+    break;
+  case ElementType::Tetra:
+    if (n_vertices == 4) {
+      return {10, nullptr};
+    }
+    if (n_vertices == 10) {
+      return {24, tetra10.data()};
+    }
+    break;
+  case ElementType::Wedge:
+    if (n_vertices == 6) {
+      return {13, wedge6.data()};
+    }
+    if (n_vertices == 15) {
+      return {26, wedge15.data()};
+    }
+    break;
+  case ElementType::Hex:
+    if (n_vertices == 8) {
+      return {12, nullptr};
+    }
+    if (n_vertices == 20) {
+      return {25, hex20.data()};
+    }
+    break;
+  }
+
+  throw std::runtime_error("unvpp::write_vtu(): Unsupported element with " +
+                           std::to_string(n_vertices) + " vertices");
+}
+
+auto is_little_endian() -> bool {
+  std::uint16_t one = 1;
+  unsigned char first_byte{};
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+auto escape_xml(const std::string &text) -> std::string {
+  std::string escaped;
+  for (auto c : text) {
+    switch (c) {
+    case '&':
+      escaped += "&amp;";
+      break;
+    case '<':
+      escaped += "&lt;";
+      break;
+    case '>':
+      escaped += "&gt;";
+      break;
+    case '"':
+      escaped += "&quot;";
+      break;
+    default:
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/* Bytes of an appended array */
+struct ArraySource {
+  /**
+   * @param n_bytes size of the array
+   * @param data the array bytes when they are stored contiguously, written
+   * without copies
+   * @param encode otherwise, fills bytes [begin, end) of the array into
+   * `out`, begin and end being multiples of the array items size
+   */
+  std::size_t n_bytes;
+  const char *data;
+  std::function<void(std::size_t begin, std::size_t end, char *out)> encode;
+};
+
+/* Writer of the arrays of the appended data section of a VTU file */
+class AppendedWriter {
+public:
+  AppendedWriter(std::ofstream &file, VtuCompression compression)
+      : _file(file), _start(file.tellp()), _compression(compression),
+        _batch_size(2 * current_executor().concurrency()) {}
+
+  auto write(const ArraySource &source) -> std::uint64_t {
+    /**
+     * @brief Append an array, split into blocks encoded (and compressed) in
+     * parallel by batches, and written in order.
+     *
+     * @return std::uint64_t Offset of the array in the appended section.
+     */
+    auto offset = static_cast<std::uint64_t>(_file.tellp() - _start);
+    if (_compression == VtuCompression::None) {
+      write_raw(source);
+    } else {
+      write_compressed(source);
+    }
+    return offset;
+  }
+
+private:
+  void write_u64(std::uint64_t value) {
+    _file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  auto block_view(const ArraySource &source, std::size_t block,
+                  std::string &buffer) const -> std::pair<const char *, std::size_t> {
+    auto begin = block * block_size;
+    auto end = std::min(source.n_bytes, begin + block_size);
+    if (source.data != nullptr) {
+      return {source.data + begin, end - begin};
+    }
+    buffer.resize(end - begin);
+    source.encode(begin, end, buffer.data());
+    return {buffer.data(), buffer.size()};
+  }
+
+  void write_raw(const ArraySource &source) {
+    write_u64(source.n_bytes);
+    if (source.data != nullptr) {
+      _file.write(source.data, static_cast<std::streamsize>(source.n_bytes));
+      return;
+    }
+
+    auto n_blocks = chunks_count(source.n_bytes, block_size);
+    std::vector<std::string> buffers(_batch_size);
+    for (std::size_t first = 0; first < n_blocks; first += _batch_size) {
+      auto n_batch = std::min(_batch_size, n_blocks - first);
+      parallel_for(n_batch, 1, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+          block_view(source, first + i, buffers[i]);
+        }
+      });
+      for (std::size_t i = 0; i < n_batch; ++i) {
+        _file.write(buffers[i].data(),
+                    static_cast<std::streamsize>(buffers[i].size()));
+      }
+    }
+  }
+
+  void write_compressed(const ArraySource &source) {
+#ifdef UNVPP_WITH_ZLIB
+    auto n_blocks = chunks_count(source.n_bytes, block_size);
+    auto last_size = source.n_bytes - (n_blocks == 0 ? 0 : (n_blocks - 1) * block_size);
+
+    // header: blocks count, block size, last block size, compressed sizes
+    std::vector<std::uint64_t> header{n_blocks, block_size, last_size};
+    header.resize(3 + n_blocks, 0);
+    auto header_position = _file.tellp();
+    _file.write(reinterpret_cast<const char *>(header.data()),
+                static_cast<std::streamsize>(header.size() * sizeof(std::uint64_t)));
+
+    std::vector<std::string> buffers(_batch_size);
+    std::vector<std::string> compressed(_batch_size);
+    for (std::size_t first = 0; first < n_blocks; first += _batch_size) {
+      auto n_batch = std::min(_batch_size, n_blocks - first);
+      parallel_for(n_batch, 1, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+          auto [data, size] = block_view(source, first + i, buffers[i]);
+          auto bound = compressBound(static_cast<uLong>(size));
+          compressed[i].resize(bound);
+          if (compress2(reinterpret_cast<Bytef *>(compressed[i].data()), &bound,
+                        reinterpret_cast<const Bytef *>(data),
+                        static_cast<uLong>(size), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            throw std::runtime_error("unvpp::write_vtu(): Compression failed");
+          }
+          compressed[i].resize(bound);
+        }
+      });
+      for (std::size_t i = 0; i < n_batch; ++i) {
+        header[3 + first + i] = compressed[i].size();
+        _file.write(compressed[i].data(),
+                    static_cast<std::streamsize>(compressed[i].size()));
+      }
+    }
+
+    auto end_position = _file.tellp();
+    _file.seekp(header_position);
+    _file.write(reinterpret_cast<const char *>(header.data()),
+                static_cast<std::streamsize>(header.size() * sizeof(std::uint64_t)));
+    _file.seekp(end_position);
+#else
+    (void)source;
+    throw std::runtime_error(
+        "unvpp::write_vtu(): unvpp was built without zlib compression");
+#endif
+  }
+
+  std::ofstream &_file;
+  std::streampos _start;
+  VtuCompression _compression;
+  std::size_t _batch_size;
+};
+
+auto group_flags(const Group &group, std::size_t n_entities)
+    -> std::vector<std::uint8_t> {
+  std::vector<std::uint8_t> flags(n_entities, 0);
+  for (const auto &range : group.elements_ids().ranges()) {
+    auto first = std::min(range.first, n_entities);
+    auto last = std::min(range.first + range.count, n_entities);
+    std::fill(flags.begin() + static_cast<std::ptrdiff_t>(first),
+              flags.begin() + static_cast<std::ptrdiff_t>(last), 1);
+  }
+  return flags;
+}
+
+} // namespace
+
+void write_vtu(const Mesh &mesh, const std::filesystem::path &path,
+               const VtuOptions &options) {
+  /**
+   * @brief Write a mesh as a VTK unstructured grid (.vtu) file.
+   *
+   * @param mesh mesh to write
+   * @param path path of the output file
+   * @param options compression and groups export
+   * @throw std::runtime_error If the file cannot be written, an element has
+   * an unsupported vertices count, or compression is not available.
+   */
+#ifndef UNVPP_WITH_ZLIB
+  if (options.compression == VtuCompression::Zlib) {
+    throw std::runtime_error(
+        "unvpp::write_vtu(): unvpp was built without zlib compression");
+  }
+#endif
+
+  static const std::vector<Element> no_elements;
+  static const std::vector<Group> no_groups;
+  const auto &vertices = mesh.vertices();
+  const auto &elements = mesh.elements().has_value() ? *mesh.elements()
+                                                     : no_elements;
+  const auto &groups = options.groups && mesh.groups().has_value()
+                           ? *mesh.groups()
+                           : no_groups;
+
+  // cells types and offsets (end of each cell connectivity)
+  std::vector<std::uint8_t> types(elements.size());
+  std::vector<std::int64_t> offsets(elements.size());
+  std::vector<const std::size_t *> orders(elements.size());
+  parallel_for(elements.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (auto e_id = begin; e_id < end; ++e_id) {
+      const auto &element = elements[e_id];
+      auto cell = vtk_cell(element.type(), element.vertices_ids().size());
+      types[e_id] = cell.type;
+      orders[e_id] = cell.order;
+      offsets[e_id] = static_cast<std::int64_t>(element.vertices_ids().size());
+    }
+  });
+  for (std::size_t e_id = 1; e_id < offsets.size(); ++e_id) {
+    offsets[e_id] += offsets[e_id - 1];
+  }
+  auto n_connectivity =
+      offsets.empty() ? std::size_t{0} : static_cast<std::size_t>(offsets.back());
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("unvpp::write_vtu(): Cannot open " +
+                             path.string() + " for writing");
+  }
+
+  // offsets of the arrays are written once known, in reserved space
+  std::vector<std::streampos> placeholders;
+  auto data_array = [&](const std::string &type, const std::string &name,
+                        std::size_t n_components) {
+    file << "        <DataArray type=\"" << type << "\" Name=\""
+         << escape_xml(name) << "\"";
+    if (n_components > 1) {
+      file << " NumberOfComponents=\"" << n_components << "\"";
+    }
+    file << " format=\"appended\" offset=\"";
+    placeholders.push_back(file.tellp());
+    file << std::string(offset_width, ' ') << "\"/>\n";
+  };
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << (is_little_endian() ? "LittleEndian" : "BigEndian")
+       << "\" header_type=\"UInt64\"";
+  if (options.compression == VtuCompression::Zlib) {
+    file << " compressor=\"vtkZLibDataCompressor\"";
+  }
+  file << ">\n  <UnstructuredGrid>\n"
+       << "    <Piece NumberOfPoints=\"" << vertices.size()
+       << "\" NumberOfCells=\"" << elements.size() << "\">\n";
+
+  file << "      <PointData>\n";
+  for (const auto &group : groups) {
+    if (group.type() == GroupType::Vertex) {
+      data_array("UInt8", group.name(), 1);
+    }
+  }
+  file << "      </PointData>\n      <CellData>\n";
+  for (const auto &group : groups) {
+    if (group.type() == GroupType::Element) {
+      data_array("UInt8", group.name(), 1);
+    }
+  }
+  file << "      </CellData>\n      <Points>\n";
+  data_array("Float64", "Points", 3);
+  file << "      </Points>\n      <Cells>\n";
+  data_array("Int64", "connectivity", 1);
+  data_array("Int64", "offsets", 1);
+  data_array("UInt8", "types", 1);
+  file << "      </Cells>\n    </Piece>\n  </UnstructuredGrid>\n"
+       << "  <AppendedData encoding=\"raw\">\n   _";
+
+  AppendedWriter writer(file, options.compression);
+  std::vector<std::uint64_t> arrays_offsets;
+
+  for (auto group_type : {GroupType::Vertex, GroupType::Element}) {
+    auto n_entities =
+        group_type == GroupType::Vertex ? vertices.size() : elements.size();
+    for (const auto &group : groups) {
+      if (group.type() == group_type) {
+        auto flags = group_flags(group, n_entities);
+        arrays_offsets.push_back(writer.write(ArraySource{
+            flags.size(), reinterpret_cast<const char *>(flags.data()), {}}));
+      }
+    }
+  }
+
+  arrays_offsets.push_back(writer.write(
+      ArraySource{vertices.size() * sizeof(std::array<double, 3>),
+                  reinterpret_cast<const char *>(vertices.data()),
+                  {}}));
+
+  // connectivity is gathered block by block, each block starting in the
+  // middle of an element in general
+  arrays_offsets.push_back(writer.write(ArraySource{
+      n_connectivity * sizeof(std::int64_t), nullptr,
+      [&](std::size_t begin, std::size_t end, char *out) {
+        auto first = begin / sizeof(std::int64_t);
+        auto last = end / sizeof(std::int64_t);
+        auto e_id = static_cast<std::size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(),
+                             static_cast<std::int64_t>(first)) -
+            offsets.begin());
+
+        for (auto k = first; k < last; ++e_id) {
+          const auto &ids = elements[e_id].vertices_ids();
+          auto element_begin = static_cast<std::size_t>(offsets[e_id]) - ids.size();
+          const auto *order = orders[e_id];
+          for (auto i = k - element_begin; i < ids.size() && k < last; ++i, ++k) {
+            auto v_id = static_cast<std::int64_t>(
+                order != nullptr ? ids[order[i]] : ids[i]);
+            std::memcpy(out + (k - first) * sizeof(std::int64_t), &v_id,
+                        sizeof(v_id));
+          }
+        }
+      }}));
+
+  arrays_offsets.push_back(writer.write(
+      ArraySource{offsets.size() * sizeof(std::int64_t),
+                  reinterpret_cast<const char *>(offsets.data()),
+                  {}}));
+  arrays_offsets.push_back(writer.write(ArraySource{
+      types.size(), reinterpret_cast<const char *>(types.data()), {}}));
+
+  file << "\n  </AppendedData>\n</VTKFile>\n";
+
+  for (std::size_t i = 0; i < placeholders.size(); ++i) {
+    file.seekp(placeholders[i]);
+    file << arrays_offsets[i];
+  }
+
+  if (!file) {
+    throw std::runtime_error("unvpp::write_vtu(): Failed to write " +
+                             path.string());
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,280 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "common.h"
+#include "format.h"
+
+namespace unvpp {
+
+namespace {
+
+// number of records formatted by one parallel chunk
+constexpr std::size_t grain = 16384;
+
+// number of ids per line of elements and groups records
+constexpr std::size_t ids_per_line = 8;
+
+void append_integer(std::string &out, std::size_t value) {
+  /**
+   * @brief Append an integer in a 10 columns field (I10).
+   */
+  constexpr std::size_t width = 10;
+  std::array<char, 24> buffer{};
+  auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                              value);
+  auto size = static_cast<std::size_t>(result.ptr - buffer.data());
+  out.append(size < width ? width - size : 0, ' ');
+  out.append(buffer.data(), size);
+}
+
+void append_real(std::string &out, double value) {
+  /**
+   * @brief Append a real in a 25 columns field with 17 significant digits
+   * (1PE25.16), enough to read back the same double.
+   */
+  constexpr std::size_t width = 25;
+  constexpr int precision = 16;
+  std::array<char, 32> buffer{};
+  auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                              value, std::chars_format::scientific, precision);
+  auto size = static_cast<std::size_t>(result.ptr - buffer.data());
+  for (std::size_t i = 0; i < size; ++i) {
+    if (buffer[i] == 'e') {
+      buffer[i] = 'E';
+    }
+  }
+  out.append(size < width ? width - size : 0, ' ');
+  out.append(buffer.data(), size);
+}
+
+auto fe_descriptor(const Element &element) -> std::size_t {
+  /**
+   * @brief UNV FE descriptor id of an element, from its type and its linear
+   * or parabolic vertices count.
+   */
+  auto n_vertices = element.vertices_ids().size();
+  auto linear = n_vertices == corners_count(element.type());
+
+  switch (element.type()) {
+  case ElementType::Line:
+    if (linear || n_vertices == 3) {
+      return linear ? 11 : 24;
+    }
+    break;
+  case ElementType::Triangle:
+    if (linear || n_vertices == 6) {
+      return linear ? 91 : 92;
+    }
+    break;
+  case ElementType::Quad:
+    if (linear || n_vertices == 8) {
+      return linear ? 94 : 95;
+    }
+    break;
+  case ElementType::Tetra:
+    if (linear || n_vertices == 10) {
+      return linear ? 111 : 118;
+    }
+    break;
+  case ElementType::Wedge:
+    if (linear || n_vertices == 15) {
+      return linear ? 112 : 113;
+    }
+    break;
+  case ElementType::Hex:
+    if (linear || n_vertices == 20) {
+      return linear ? 115 : 116;
+    }
+    break;
+  }
+
+  throw std::runtime_error("unvpp::write(): Unsupported element with " +
+                           std::to_string(n_vertices) + " vertices");
+}
+
+void write_dataset_begin(std::ofstream &file, std::string_view tag) {
+  file << "    -1\n" << tag << "\n";
+}
+
+void write_dataset_end(std::ofstream &file) { file << "    -1\n"; }
+
+void write_units(std::ofstream &file, const UnitsSystem &units) {
+  /**
+   * @brief Write units dataset 164, with unit force and temperature scales.
+   */
+  constexpr double temperature_offset = 273.15;
+  std::string out;
+  append_integer(out, units.code());
+  out += "  " + units.to_string();
+  append_integer(out, 2);
+  out += '\n';
+  append_real(out, units.length_scale());
+  append_real(out, 1.);
+  append_real(out, 1.);
+  out += '\n';
+  append_real(out, temperature_offset);
+  out += '\n';
+
+  write_dataset_begin(file, UNITS_TAG);
+  file << out;
+  write_dataset_end(file);
+}
+
+void write_vertices(std::ofstream &file,
+                    const std::vector<std::array<double, 3>> &vertices) {
+  /**
+   * @brief Write vertices dataset 2411, labelled from 1 in the global
+   * cartesian coordinate system.
+   */
+  write_dataset_begin(file, VERTICES_TAG);
+  write_formatted(file, vertices.size(), grain,
+                  [&](std::size_t v_id, std::string &out) {
+                    append_integer(out, v_id + 1);
+                    append_integer(out, 1);
+                    append_integer(out, 1);
+                    append_integer(out, 11);
+                    out += '\n';
+                    for (auto x : vertices[v_id]) {
+                      append_real(out, x);
+                    }
+                    out += '\n';
+                  });
+  write_dataset_end(file);
+}
+
+void write_elements(std::ofstream &file, const std::vector<Element> &elements) {
+  /**
+   * @brief Write elements dataset 2412, labelled from 1, beams with a
+   * default orientation record.
+   */
+  write_dataset_begin(file, ELEMENTS_TAG);
+  write_formatted(
+      file, elements.size(), grain, [&](std::size_t e_id, std::string &out) {
+        const auto &element = elements[e_id];
+        const auto &ids = element.vertices_ids();
+        append_integer(out, e_id + 1);
+        append_integer(out, fe_descriptor(element));
+        append_integer(out, 2);
+        append_integer(out, 1);
+        append_integer(out, 7);
+        append_integer(out, ids.size());
+        out += '\n';
+
+        if (is_beam_type(element.type())) {
+          append_integer(out, 0);
+          append_integer(out, 1);
+          append_integer(out, 1);
+          out += '\n';
+        }
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+          append_integer(out, ids[i] + 1);
+          if ((i + 1) % ids_per_line == 0 || i + 1 == ids.size()) {
+            out += '\n';
+          }
+        }
+      });
+  write_dataset_end(file);
+}
+
+void write_groups(std::ofstream &file, const std::vector<Group> &groups) {
+  /**
+   * @brief Write groups dataset 2467, with two members per line.
+   */
+  write_dataset_begin(file, GROUP_TAGS[1]);
+  for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+    const auto &group = groups[g_id];
+    const auto &members = group.elements_ids();
+    auto entity_type = group.type() == GroupType::Element ? 8 : 7;
+
+    std::string out;
+    append_integer(out, g_id + 1);
+    for (std::size_t i = 0; i < 6; ++i) {
+      append_integer(out, 0);
+    }
+    append_integer(out, members.size());
+    out += '\n' + group.name() + '\n';
+    file << out;
+
+    auto n_rows = (members.size() + 1) / 2;
+    auto values = members.to_vector();
+    write_formatted(file, n_rows, grain, [&](std::size_t row, std::string &line) {
+      for (auto i = 2 * row; i < std::min(2 * row + 2, values.size()); ++i) {
+        append_integer(line, entity_type);
+        append_integer(line, values[i] + 1);
+        append_integer(line, 0);
+        append_integer(line, 0);
+      }
+      line += '\n';
+    });
+  }
+  write_dataset_end(file);
+}
+
+} // namespace
+
+void write(const std::filesystem::path &path, const Mesh &mesh) {
+  /**
+   * @brief Write a mesh as a UNV file.
+   *
+   * @param path path to the output UNV file
+   * @param mesh the mesh
+   */
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("unvpp::write(): Cannot open " + path.string() +
+                             " for writing");
+  }
+
+  if (mesh.unit_system().has_value()) {
+    write_units(file, *mesh.unit_system());
+  }
+
+  write_vertices(file, mesh.vertices());
+
+  if (mesh.elements().has_value()) {
+    write_elements(file, *mesh.elements());
+  }
+
+  if (mesh.groups().has_value() && !mesh.groups()->empty()) {
+    write_groups(file, *mesh.groups());
+  }
+
+  file.close();
+  if (!file) {
+    throw std::runtime_error("unvpp::write(): Failed to write " +
+                             path.string());
+  }
+}
+
+} // namespace unvpp
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+
+template <unvpp::ElementType Type>
+void expect_block_matches(const unvpp::Mesh& mesh, const unvpp::ElementBlocks& blocks) {
+    const auto& block = blocks.get<Type>();
+    const auto& elements = mesh.elements().value();
+    ASSERT_EQ(block.vertices_ids.size(), block.elements_ids.size());
+
+    for (std::size_t i = 0; i < block.elements_ids.size(); ++i) {
+        const auto& element = elements[block.elements_ids[i]];
+        EXPECT_EQ(element.type(), Type);
+        for (std::size_t c = 0; c < block.n_vertices; ++c) {
+            EXPECT_EQ(block.vertices_ids[i][c], element.vertices_ids()[c]);
+        }
+        if (i > 0) {
+            EXPECT_LT(block.elements_ids[i - 1], block.elements_ids[i]);
+        }
+    }
+}
+
+TEST(MeshBlocksTest, BlocksByType) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto blocks = mesh.element_blocks();
+
+    static_assert(decltype(blocks.hexes)::n_vertices == 8);
+    static_assert(decltype(blocks.wedges)::n_vertices == 6);
+    static_assert(decltype(blocks.tetras)::n_vertices == 4);
+
+    EXPECT_EQ(blocks.lines.elements_ids.size(), 141);
+    EXPECT_EQ(blocks.triangles.elements_ids.size(), 2786);
+    EXPECT_EQ(blocks.quads.elements_ids.size(), 315);
+    EXPECT_EQ(blocks.wedges.elements_ids.size(), 3525);
+    EXPECT_EQ(blocks.tetras.elements_ids.size(), 15217);
+    EXPECT_EQ(blocks.hexes.elements_ids.size(), 0);
+
+    expect_block_matches<unvpp::ElementType::Line>(mesh, blocks);
+    expect_block_matches<unvpp::ElementType::Triangle>(mesh, blocks);
+    expect_block_matches<unvpp::ElementType::Quad>(mesh, blocks);
+    expect_block_matches<unvpp::ElementType::Tetra>(mesh, blocks);
+    expect_block_matches<unvpp::ElementType::Wedge>(mesh, blocks);
+}
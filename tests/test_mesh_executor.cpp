@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <unvpp/executor.h>
+#include <unvpp/geometry.h>
+#include <unvpp/quality.h>
+#include <unvpp/unvpp.h>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace {
+
+const auto cylinder_path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+
+// executor of a host application, running tasks in reverse order
+class ReverseExecutor final : public unvpp::Executor {
+  public:
+    void parallel_for(std::size_t n_tasks, const std::function<void(std::size_t)>& task) override {
+        n_calls.fetch_add(1);
+        for (auto i = n_tasks; i > 0; --i) {
+            task(i - 1);
+        }
+    }
+    auto concurrency() const noexcept -> std::size_t override { return 3; }
+
+    std::atomic<std::size_t> n_calls{0};
+};
+
+void expect_same_geometry(const unvpp::Geometry& lhs, const unvpp::Geometry& rhs) {
+    EXPECT_EQ(lhs.centroids, rhs.centroids);
+    EXPECT_EQ(lhs.measures, rhs.measures);
+    EXPECT_EQ(lhs.area_vectors, rhs.area_vectors);
+    EXPECT_EQ(lhs.faces_offsets, rhs.faces_offsets);
+    EXPECT_EQ(lhs.face_area_vectors, rhs.face_area_vectors);
+    EXPECT_EQ(lhs.bounding_box.lower, rhs.bounding_box.lower);
+    EXPECT_EQ(lhs.bounding_box.upper, rhs.bounding_box.upper);
+    // compared bitwise, not up to rounding
+    EXPECT_EQ(lhs.total_volume, rhs.total_volume);
+}
+
+void expect_same_quality(const unvpp::QualityReport& lhs, const unvpp::QualityReport& rhs) {
+    for (std::size_t type = 0; type < lhs.histograms.size(); ++type) {
+        for (std::size_t m = 0; m < lhs.histograms[type].size(); ++m) {
+            const auto& a = lhs.histograms[type][m];
+            const auto& b = rhs.histograms[type][m];
+            EXPECT_EQ(a.counts, b.counts);
+            EXPECT_EQ(a.min, b.min);
+            EXPECT_EQ(a.max, b.max);
+            EXPECT_EQ(a.sum, b.sum);
+        }
+    }
+    for (std::size_t m = 0; m < lhs.worst.size(); ++m) {
+        ASSERT_EQ(lhs.worst[m].size(), rhs.worst[m].size());
+        for (std::size_t i = 0; i < lhs.worst[m].size(); ++i) {
+            EXPECT_EQ(lhs.worst[m][i].element, rhs.worst[m][i].element);
+            EXPECT_EQ(lhs.worst[m][i].value, rhs.worst[m][i].value);
+        }
+    }
+}
+
+} // namespace
+
+TEST(MeshExecutorTest, SameResultsOnAnyExecutor) {
+    auto mesh = unvpp::read(cylinder_path);
+
+    unvpp::SequentialExecutor sequential;
+    unvpp::Geometry geometry;
+    unvpp::QualityReport quality;
+    {
+        unvpp::ExecutorScope scope(sequential);
+        geometry = unvpp::compute_geometry(mesh);
+        quality = unvpp::analyze_quality(mesh, unvpp::QualityOptions{10});
+    }
+
+    unvpp::ThreadPool two(2);
+    unvpp::ThreadPool seven(7);
+    ReverseExecutor reverse;
+    std::vector<unvpp::Executor*> executors{&two, &seven, &reverse, &unvpp::default_executor()};
+
+    for (auto* executor : executors) {
+        unvpp::ExecutorScope scope(*executor);
+        expect_same_geometry(unvpp::compute_geometry(mesh), geometry);
+        expect_same_quality(unvpp::analyze_quality(mesh, unvpp::QualityOptions{10}), quality);
+    }
+    EXPECT_GT(reverse.n_calls.load(), 0);
+}
+
+TEST(MeshExecutorTest, ReadOptions) {
+    ReverseExecutor reverse;
+    auto mesh = unvpp::read(cylinder_path, unvpp::ReadOptions{&reverse});
+    auto expected = unvpp::read(cylinder_path);
+
+    EXPECT_EQ(mesh.vertices(), expected.vertices());
+    ASSERT_EQ(mesh.elements()->size(), expected.elements()->size());
+    for (std::size_t i = 0; i < mesh.elements()->size(); ++i) {
+        EXPECT_EQ(mesh.elements()->at(i).vertices_ids(), expected.elements()->at(i).vertices_ids());
+    }
+
+    // the scope of the read does not leak to the caller
+    EXPECT_EQ(&unvpp::current_executor(), &unvpp::default_executor());
+}
+
+TEST(MeshExecutorTest, NestedLoops) {
+    unvpp::ThreadPool pool(3);
+    std::atomic<std::size_t> n_runs{0};
+
+    pool.parallel_for(8, [&](std::size_t) {
+        pool.parallel_for(8, [&](std::size_t) { n_runs.fetch_add(1); });
+    });
+    EXPECT_EQ(n_runs.load(), 64);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <unvpp/executor.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+const auto cylinder_path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+
+auto shifted_copy(const unvpp::Mesh& mesh, std::size_t vertex, double shift) -> unvpp::Mesh {
+    auto vertices = mesh.vertices();
+    vertices[vertex][0] += shift;
+    return unvpp::Mesh(std::move(vertices), mesh.elements(), mesh.groups(), mesh.unit_system());
+}
+
+} // namespace
+
+TEST(MeshFingerprintTest, SameMesh) {
+    auto mesh = unvpp::read(cylinder_path);
+    auto fingerprint = mesh.fingerprint();
+    EXPECT_EQ(unvpp::read(cylinder_path).fingerprint(), fingerprint);
+    EXPECT_NE(fingerprint.vertices, fingerprint.connectivity);
+
+    // written and read back meshes are the same
+    auto path = std::filesystem::temp_directory_path() / "unvpp_fingerprint.unv";
+    unvpp::write(path, mesh);
+    EXPECT_EQ(unvpp::read(path).fingerprint(), fingerprint);
+    std::filesystem::remove(path);
+
+    // fingerprints do not depend on the executor
+    unvpp::SequentialExecutor sequential;
+    unvpp::ExecutorScope scope(sequential);
+    EXPECT_EQ(mesh.fingerprint().combined(), fingerprint.combined());
+}
+
+TEST(MeshFingerprintTest, Differences) {
+    auto mesh = unvpp::read(cylinder_path);
+    auto fingerprint = mesh.fingerprint();
+
+    auto shifted = shifted_copy(mesh, 100, 1e-3).fingerprint();
+    EXPECT_NE(shifted.vertices, fingerprint.vertices);
+    EXPECT_EQ(shifted.connectivity, fingerprint.connectivity);
+    EXPECT_EQ(shifted.groups, fingerprint.groups);
+    EXPECT_EQ(shifted.units, fingerprint.units);
+    EXPECT_NE(shifted.combined(), fingerprint.combined());
+
+    auto renumbered = mesh;
+    renumbered.renumber(unvpp::Ordering::ReverseCuthillMcKee);
+    EXPECT_NE(renumbered.fingerprint().connectivity, fingerprint.connectivity);
+}
+
+TEST(MeshFingerprintTest, Tolerance) {
+    auto mesh = unvpp::read("../../tests/meshes/eight_hex_cube_with_groups.unv");
+
+    // coordinates are multiples of 0.5, away from rounding boundaries
+    auto noisy = shifted_copy(mesh, 3, 1e-12);
+    EXPECT_NE(noisy.fingerprint().vertices, mesh.fingerprint().vertices);
+    EXPECT_EQ(noisy.fingerprint(1e-6).vertices, mesh.fingerprint(1e-6).vertices);
+
+    EXPECT_THROW(mesh.fingerprint(-1.), std::runtime_error);
+}
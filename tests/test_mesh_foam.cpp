@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <unvpp/foam.h>
+#include <unvpp/unvpp.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Point = std::array<double, 3>;
+
+auto foam_body(const std::filesystem::path& path) -> std::string {
+    std::ifstream file(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return content.substr(content.find("}\n\n") + 3);
+}
+
+auto read_labels(const std::filesystem::path& path) -> std::vector<std::size_t> {
+    std::istringstream stream(foam_body(path));
+    std::size_t n{};
+    char bracket{};
+    stream >> n >> bracket;
+    std::vector<std::size_t> labels(n);
+    for (auto& label : labels) {
+        stream >> label;
+    }
+    return labels;
+}
+
+auto read_faces(const std::filesystem::path& path) -> std::vector<std::vector<std::size_t>> {
+    std::istringstream stream(foam_body(path));
+    std::size_t n{};
+    char bracket{};
+    stream >> n >> bracket;
+    std::vector<std::vector<std::size_t>> faces(n);
+    for (auto& face : faces) {
+        std::size_t size{};
+        stream >> size >> bracket;
+        face.resize(size);
+        for (auto& id : face) {
+            stream >> id;
+        }
+        stream >> bracket;
+    }
+    return faces;
+}
+
+auto read_points(const std::filesystem::path& path) -> std::vector<Point> {
+    std::istringstream stream(foam_body(path));
+    std::size_t n{};
+    char bracket{};
+    stream >> n >> bracket;
+    std::vector<Point> points(n);
+    for (auto& point : points) {
+        stream >> bracket >> point[0] >> point[1] >> point[2] >> bracket;
+    }
+    return points;
+}
+
+auto area_vector(const std::vector<Point>& points, const std::vector<std::size_t>& face) -> Point {
+    // Newell's formula
+    Point area{0., 0., 0.};
+    for (std::size_t i = 0; i < face.size(); ++i) {
+        const auto& a = points[face[i]];
+        const auto& b = points[face[(i + 1) % face.size()]];
+        area[0] += 0.5 * (a[1] - b[1]) * (a[2] + b[2]);
+        area[1] += 0.5 * (a[2] - b[2]) * (a[0] + b[0]);
+        area[2] += 0.5 * (a[0] - b[0]) * (a[1] + b[1]);
+    }
+    return area;
+}
+
+void expect_valid_polymesh(const std::filesystem::path& directory, std::size_t n_cells) {
+    auto points = read_points(directory / "points");
+    auto faces = read_faces(directory / "faces");
+    auto owner = read_labels(directory / "owner");
+    auto neighbour = read_labels(directory / "neighbour");
+    ASSERT_EQ(owner.size(), faces.size());
+    ASSERT_LE(neighbour.size(), faces.size());
+
+    // internal faces are upper triangular, ordered by owner then neighbour
+    for (std::size_t face = 0; face < neighbour.size(); ++face) {
+        EXPECT_LT(owner[face], neighbour[face]);
+        if (face > 0) {
+            EXPECT_TRUE(owner[face - 1] < owner[face] ||
+                        (owner[face - 1] == owner[face] && neighbour[face - 1] < neighbour[face]));
+        }
+    }
+
+    // cells are closed by their faces, oriented outward of their owner
+    std::vector<Point> sums(n_cells, Point{0., 0., 0.});
+    std::vector<std::set<std::size_t>> cells_points(n_cells);
+    for (std::size_t face = 0; face < faces.size(); ++face) {
+        auto area = area_vector(points, faces[face]);
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            sums[owner[face]][axis] += area[axis];
+            if (face < neighbour.size()) {
+                sums[neighbour[face]][axis] -= area[axis];
+            }
+        }
+        cells_points[owner[face]].insert(faces[face].begin(), faces[face].end());
+        if (face < neighbour.size()) {
+            cells_points[neighbour[face]].insert(faces[face].begin(), faces[face].end());
+        }
+    }
+
+    for (std::size_t face = 0; face < faces.size(); ++face) {
+        Point center{0., 0., 0.};
+        for (auto id : cells_points[owner[face]]) {
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                center[axis] += points[id][axis] / static_cast<double>(cells_points[owner[face]].size());
+            }
+        }
+        auto area = area_vector(points, faces[face]);
+        double outward = 0.;
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            outward += area[axis] * (points[faces[face][0]][axis] - center[axis]);
+        }
+        EXPECT_GT(outward, 0.);
+    }
+
+    for (const auto& sum : sums) {
+        EXPECT_NEAR(std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]), 0., 1e-9);
+    }
+}
+
+TEST(MeshFoamTest, EightHexCube) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/eight_hex_cube_with_groups.unv"));
+    auto directory = std::filesystem::temp_directory_path() / "unvpp_foam_cube" / "polyMesh";
+    unvpp::write_foam(mesh, directory);
+
+    EXPECT_EQ(read_points(directory / "points"), mesh.vertices());
+    EXPECT_EQ(read_faces(directory / "faces").size(), 36);
+    EXPECT_EQ(read_labels(directory / "neighbour").size(), 12);
+    expect_valid_polymesh(directory, 8);
+
+    auto boundary = foam_body(directory / "boundary");
+    EXPECT_NE(boundary.find("walls\n    {\n        type            patch;\n"
+                            "        nFaces          16;\n        startFace       12;"),
+              std::string::npos);
+    EXPECT_NE(boundary.find("inout\n    {\n        type            patch;\n"
+                            "        nFaces          8;\n        startFace       28;"),
+              std::string::npos);
+    EXPECT_EQ(boundary.find("defaultFaces"), std::string::npos);
+    std::filesystem::remove_all(directory.parent_path());
+}
+
+TEST(MeshFoamTest, Cylinder) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv"));
+    auto directory = std::filesystem::temp_directory_path() / "unvpp_foam_cylinder" / "polyMesh";
+    unvpp::write_foam(mesh, directory);
+
+    std::size_t n_cells = 0;
+    for (const auto& element : mesh.elements().value()) {
+        n_cells += element.type() == unvpp::ElementType::Tetra ||
+                   element.type() == unvpp::ElementType::Wedge ||
+                   element.type() == unvpp::ElementType::Hex;
+    }
+    expect_valid_polymesh(directory, n_cells);
+    std::filesystem::remove_all(directory.parent_path());
+}
+
+TEST(MeshFoamTest, Binary) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/one_hex_cell.unv"));
+    auto directory = std::filesystem::temp_directory_path() / "unvpp_foam_binary" / "polyMesh";
+    auto options = unvpp::FoamOptions();
+    options.format = unvpp::FoamFormat::Binary;
+    unvpp::write_foam(mesh, directory, options);
+
+    auto owner = foam_body(directory / "owner");
+    ASSERT_EQ(owner.substr(0, 3), "6\n(");
+    std::array<std::int32_t, 6> labels{};
+    std::memcpy(labels.data(), owner.data() + 3, sizeof(labels));
+    EXPECT_EQ(labels, (std::array<std::int32_t, 6>{0, 0, 0, 0, 0, 0}));
+
+    auto faces = foam_body(directory / "faces");
+    ASSERT_EQ(faces.substr(0, 3), "7\n(");
+    std::array<std::int32_t, 7> offsets{};
+    std::memcpy(offsets.data(), faces.data() + 3, sizeof(offsets));
+    EXPECT_EQ(offsets, (std::array<std::int32_t, 7>{0, 4, 8, 12, 16, 20, 24}));
+    EXPECT_NE(faces.find("\n24\n("), std::string::npos);
+    std::filesystem::remove_all(directory.parent_path());
+}
+
+TEST(MeshFoamTest, NoCells) {
+    auto mesh = unvpp::Mesh({{0., 0., 0.}}, std::nullopt, std::nullopt, std::nullopt);
+    EXPECT_THROW(unvpp::write_foam(mesh, std::filesystem::temp_directory_path() / "unvpp_foam_empty"),
+                 std::runtime_error);
+}
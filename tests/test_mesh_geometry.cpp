@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <unvpp/geometry.h>
+#include <unvpp/unvpp.h>
+#include <array>
+#include <cmath>
+#include <filesystem>
+
+TEST(MeshGeometryTest, HexCube) {
+    auto path = std::filesystem::path("../../tests/meshes/eight_hex_cube_with_groups.unv");
+    auto mesh = unvpp::read(path);
+    auto geometry = unvpp::compute_geometry(mesh);
+    const auto& elements = mesh.elements().value();
+
+    ASSERT_EQ(geometry.measures.size(), elements.size());
+    ASSERT_EQ(geometry.faces_offsets.size(), elements.size() + 1);
+    EXPECT_EQ(geometry.face_area_vectors.size(), geometry.faces_offsets.back());
+    EXPECT_NEAR(geometry.total_volume, 1., 1e-12);
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        EXPECT_DOUBLE_EQ(geometry.bounding_box.lower[axis], 0.);
+        EXPECT_DOUBLE_EQ(geometry.bounding_box.upper[axis], 1.);
+    }
+
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        const auto& area_vector = geometry.area_vectors[e_id];
+        auto area = std::sqrt(area_vector[0] * area_vector[0] + area_vector[1] * area_vector[1] +
+                              area_vector[2] * area_vector[2]);
+
+        switch (elements[e_id].type()) {
+        case unvpp::ElementType::Hex: {
+            EXPECT_NEAR(geometry.measures[e_id], 0.125, 1e-12);
+            EXPECT_DOUBLE_EQ(area, 0.);
+            for (auto x : geometry.centroids[e_id]) {
+                EXPECT_TRUE(std::abs(x - 0.25) < 1e-12 || std::abs(x - 0.75) < 1e-12);
+            }
+
+            // six axis aligned faces of a closed cell
+            ASSERT_EQ(geometry.faces_offsets[e_id + 1] - geometry.faces_offsets[e_id], 6);
+            std::array<double, 3> sum{0., 0., 0.};
+            for (auto f = geometry.faces_offsets[e_id]; f < geometry.faces_offsets[e_id + 1]; ++f) {
+                const auto& face = geometry.face_area_vectors[f];
+                EXPECT_NEAR(std::abs(face[0]) + std::abs(face[1]) + std::abs(face[2]), 0.25, 1e-12);
+                for (std::size_t axis = 0; axis < 3; ++axis) {
+                    sum[axis] += face[axis];
+                }
+            }
+            for (auto x : sum) {
+                EXPECT_NEAR(x, 0., 1e-12);
+            }
+            break;
+        }
+        case unvpp::ElementType::Quad:
+            EXPECT_NEAR(geometry.measures[e_id], 0.25, 1e-12);
+            EXPECT_NEAR(area, 0.25, 1e-12);
+            EXPECT_EQ(geometry.faces_offsets[e_id + 1], geometry.faces_offsets[e_id]);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+TEST(MeshGeometryTest, MixedCells) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto geometry = unvpp::compute_geometry(mesh);
+    const auto& elements = mesh.elements().value();
+
+    // tetrahedra volumes against the triple product formula
+    double volume = 0.;
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        auto type = elements[e_id].type();
+        if (type == unvpp::ElementType::Tetra || type == unvpp::ElementType::Wedge) {
+            EXPECT_GT(geometry.measures[e_id], 0.);
+            volume += geometry.measures[e_id];
+        }
+        if (type != unvpp::ElementType::Tetra) {
+            continue;
+        }
+
+        const auto& ids = elements[e_id].vertices_ids();
+        const auto& a = mesh.vertices()[ids[0]];
+        std::array<std::array<double, 3>, 3> edges;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                edges[i][axis] = mesh.vertices()[ids[i + 1]][axis] - a[axis];
+            }
+        }
+        auto triple = edges[0][0] * (edges[1][1] * edges[2][2] - edges[1][2] * edges[2][1]) -
+                      edges[0][1] * (edges[1][0] * edges[2][2] - edges[1][2] * edges[2][0]) +
+                      edges[0][2] * (edges[1][0] * edges[2][1] - edges[1][1] * edges[2][0]);
+        EXPECT_NEAR(geometry.measures[e_id], std::abs(triple) / 6., 1e-12);
+
+        // each face points away from the vertex it leaves out, at a distance
+        // giving back the tetrahedron volume
+        constexpr std::array<std::array<std::size_t, 2>, 4> face_and_opposite = {
+            {{0, 3}, {0, 2}, {1, 0}, {0, 1}}};
+        ASSERT_EQ(geometry.faces_offsets[e_id + 1] - geometry.faces_offsets[e_id], 4);
+        for (std::size_t f = 0; f < 4; ++f) {
+            const auto& face = geometry.face_area_vectors[geometry.faces_offsets[e_id] + f];
+            const auto& on_face = mesh.vertices()[ids[face_and_opposite[f][0]]];
+            const auto& opposite = mesh.vertices()[ids[face_and_opposite[f][1]]];
+            double projection = 0.;
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                projection += face[axis] * (opposite[axis] - on_face[axis]);
+            }
+            EXPECT_LT(projection, 0.);
+            EXPECT_NEAR(-projection / 3., geometry.measures[e_id], 1e-12);
+        }
+    }
+
+    EXPECT_NEAR(geometry.total_volume, volume, 1e-9 * volume);
+}
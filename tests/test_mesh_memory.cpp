@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <array>
+#include <filesystem>
+#include <vector>
+
+namespace {
+
+auto make_slack_mesh() -> unvpp::Mesh {
+    std::vector<std::array<double, 3>> vertices;
+    vertices.reserve(100);
+    vertices.push_back({0., 0., 0.});
+    vertices.push_back({1., 0., 0.});
+    vertices.push_back({0., 1., 0.});
+    vertices.push_back({0., 0., 1.});
+
+    std::vector<std::size_t> tetra_ids;
+    tetra_ids.reserve(20);
+    tetra_ids.insert(tetra_ids.end(), {0, 1, 2, 3});
+
+    std::vector<unvpp::Element> elements;
+    elements.reserve(10);
+    elements.emplace_back(tetra_ids, unvpp::ElementType::Tetra);
+    elements.emplace_back(std::vector<std::size_t>{0, 1, 2}, unvpp::ElementType::Triangle);
+    // the copy into the element keeps no slack, put it back
+    elements[0].vertices_ids() = std::move(tetra_ids);
+
+    std::vector<unvpp::Group> groups;
+    groups.reserve(5);
+    groups.emplace_back("wall", unvpp::GroupType::Element, unvpp::GroupMembers({1}));
+
+    return unvpp::Mesh(std::move(vertices), std::move(elements), std::move(groups), std::nullopt);
+}
+
+} // namespace
+
+TEST(MeshMemoryTest, Breakdown) {
+    auto mesh = make_slack_mesh();
+    auto usage = mesh.memory_usage();
+
+    EXPECT_EQ(usage.vertices, 4 * sizeof(std::array<double, 3>));
+    EXPECT_EQ(usage.connectivity, 7 * sizeof(std::size_t) + 2 * sizeof(unvpp::ElementType));
+    EXPECT_EQ(usage.groups, 4 + sizeof(unvpp::GroupMembers::Range) + sizeof(std::size_t));
+    EXPECT_EQ(usage.total(), usage.vertices + usage.connectivity + usage.groups + usage.overhead);
+
+    // 96 unused vertices slots, 8 unused elements and 16 unused tetra ids
+    EXPECT_GE(usage.overhead, 96 * sizeof(std::array<double, 3>) + 8 * sizeof(unvpp::Element) +
+                                  16 * sizeof(std::size_t));
+}
+
+TEST(MeshMemoryTest, Compact) {
+    auto mesh = make_slack_mesh();
+    auto before = mesh.memory_usage();
+    auto vertices = mesh.vertices();
+    auto tetra_ids = mesh.elements()->at(0).vertices_ids();
+
+    mesh.compact();
+    auto after = mesh.memory_usage();
+
+    EXPECT_EQ(after.vertices, before.vertices);
+    EXPECT_EQ(after.connectivity, before.connectivity);
+    EXPECT_EQ(after.groups, before.groups);
+    // only the objects headers are left
+    EXPECT_EQ(after.overhead, sizeof(unvpp::Mesh) + 2 * sizeof(unvpp::Element) -
+                                  2 * sizeof(unvpp::ElementType) + sizeof(unvpp::Group));
+
+    EXPECT_EQ(mesh.vertices(), vertices);
+    EXPECT_EQ(mesh.elements()->at(0).vertices_ids(), tetra_ids);
+    EXPECT_EQ(mesh.groups()->at(0).elements_ids(), unvpp::GroupMembers({1}));
+}
+
+TEST(MeshMemoryTest, ReadMesh) {
+    auto mesh = unvpp::read("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto usage = mesh.memory_usage();
+    EXPECT_EQ(usage.vertices, mesh.vertices().size() * sizeof(std::array<double, 3>));
+
+    // the reader allocates arrays to their exact size
+    mesh.compact();
+    EXPECT_EQ(mesh.memory_usage().total(), usage.total());
+}
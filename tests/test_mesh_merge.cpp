@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+
+auto two_hex_cells(double gap) -> unvpp::Mesh {
+    // two copies of the unit hex cell, the second one shifted along x so that
+    // its face at x = 0 lies `gap` away from the first cell face at x = 1
+    auto path = std::filesystem::path("../../tests/meshes/one_hex_cell.unv");
+    auto cell = unvpp::read(path);
+
+    std::vector<std::array<double, 3>> vertices = cell.vertices();
+    for (const auto& vertex : cell.vertices()) {
+        vertices.push_back({vertex[0] + 1. + gap, vertex[1], vertex[2]});
+    }
+
+    std::vector<unvpp::Element> elements;
+    for (std::size_t shift : {std::size_t{0}, cell.vertices().size()}) {
+        for (const auto& element : cell.elements().value()) {
+            auto ids = element.vertices_ids();
+            for (auto& v_id : ids) {
+                v_id += shift;
+            }
+            elements.emplace_back(ids, element.type());
+        }
+    }
+
+    std::vector<std::size_t> all_vertices(vertices.size());
+    for (std::size_t v_id = 0; v_id < vertices.size(); ++v_id) {
+        all_vertices[v_id] = v_id;
+    }
+    std::vector<unvpp::Group> groups{
+        unvpp::Group("nodes", unvpp::GroupType::Vertex, all_vertices)};
+
+    return unvpp::Mesh(vertices, elements, groups, cell.unit_system());
+}
+
+TEST(MeshMergeTest, MergeCoincidentFaces) {
+    auto mesh = two_hex_cells(1e-9);
+    auto original = mesh;
+    ASSERT_EQ(mesh.vertices().size(), 16);
+
+    auto new_ids = mesh.merge_vertices(1e-6);
+    ASSERT_EQ(new_ids.size(), 16);
+    EXPECT_EQ(mesh.vertices().size(), 12);
+    EXPECT_EQ(mesh.groups().value()[0].elements_ids().size(), 12);
+
+    // connectivity points to the kept vertices, within tolerance
+    const auto& elements = mesh.elements().value();
+    const auto& original_elements = original.elements().value();
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        const auto& ids = elements[e_id].vertices_ids();
+        const auto& original_ids = original_elements[e_id].vertices_ids();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(ids[i], new_ids[original_ids[i]]);
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                EXPECT_NEAR(mesh.vertices()[ids[i]][axis],
+                            original.vertices()[original_ids[i]][axis],
+                            1e-6);
+            }
+        }
+    }
+}
+
+TEST(MeshMergeTest, KeepDistinctVertices) {
+    auto mesh = two_hex_cells(1e-3);
+    auto new_ids = mesh.merge_vertices(1e-6);
+    EXPECT_EQ(mesh.vertices().size(), 16);
+
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto cylinder = unvpp::read(path);
+    cylinder.merge_vertices(0.);
+    EXPECT_EQ(cylinder.vertices().size(), 5207);
+
+    EXPECT_THROW(cylinder.merge_vertices(-1.), std::runtime_error);
+    // the extent of the mesh over the tolerance overflows the grid cells
+    EXPECT_THROW(cylinder.merge_vertices(1e-300), std::runtime_error);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <unvpp/partition.h>
+#include <unvpp/unvpp.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+TEST(MeshPartitionTest, BalancedParts) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    const auto& elements = mesh.elements().value();
+
+    constexpr std::size_t n_parts = 4;
+    auto parts = unvpp::partition(mesh, n_parts);
+    ASSERT_EQ(parts.size(), elements.size());
+
+    // volume cells are balanced within the refinement tolerance
+    std::vector<std::size_t> sizes(n_parts, 0);
+    std::size_t n_cells = 0;
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        ASSERT_LT(parts[e_id], n_parts);
+        auto type = elements[e_id].type();
+        if (type == unvpp::ElementType::Tetra || type == unvpp::ElementType::Wedge) {
+            ++sizes[parts[e_id]];
+            ++n_cells;
+        }
+    }
+    for (auto size : sizes) {
+        EXPECT_LE(size, n_cells / n_parts * 1.03 + 1);
+        EXPECT_GE(size, n_cells / n_parts * 0.97 - 1);
+    }
+
+    auto single = unvpp::partition(mesh, 1);
+    EXPECT_TRUE(std::all_of(single.begin(), single.end(), [](auto p) { return p == 0; }));
+    EXPECT_THROW(unvpp::partition(mesh, 0), std::runtime_error);
+}
+
+TEST(MeshPartitionTest, ExtractSubdomains) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+
+    auto parts = unvpp::partition(mesh, 3);
+    auto subdomains = unvpp::extract_subdomains(mesh, parts);
+    ASSERT_EQ(subdomains.size(), 3);
+
+    std::size_t n_elements = 0;
+    std::vector<std::size_t> group_sizes(mesh.groups().value().size(), 0);
+
+    for (std::size_t part = 0; part < subdomains.size(); ++part) {
+        const auto& subdomain = subdomains[part];
+        const auto& local = subdomain.mesh;
+        n_elements += local.elements().value().size();
+
+        // local connectivity matches the global one
+        for (std::size_t e_id = 0; e_id < local.elements().value().size(); ++e_id) {
+            const auto& element = local.elements().value()[e_id];
+            const auto& global = mesh.elements().value()[subdomain.elements[e_id]];
+            ASSERT_EQ(parts[subdomain.elements[e_id]], part);
+            ASSERT_EQ(element.type(), global.type());
+            for (std::size_t i = 0; i < element.vertices_ids().size(); ++i) {
+                EXPECT_EQ(subdomain.vertices[element.vertices_ids()[i]],
+                          global.vertices_ids()[i]);
+            }
+        }
+
+        // both sides of an interface list the same global vertices
+        for (const auto& interface : subdomain.interfaces) {
+            const auto& other = subdomains[interface.part];
+            auto iter = std::find_if(other.interfaces.begin(), other.interfaces.end(),
+                                     [&](const auto& i) { return i.part == part; });
+            ASSERT_NE(iter, other.interfaces.end());
+            ASSERT_EQ(iter->vertices.size(), interface.vertices.size());
+            for (std::size_t i = 0; i < interface.vertices.size(); ++i) {
+                EXPECT_EQ(subdomain.vertices[interface.vertices[i]],
+                          other.vertices[iter->vertices[i]]);
+            }
+        }
+        EXPECT_FALSE(subdomain.interfaces.empty());
+        EXPECT_FALSE(subdomain.halo_elements.empty());
+
+        const auto& groups = local.groups().value();
+        for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+            group_sizes[g_id] += groups[g_id].elements_ids().size();
+
+            // element types are those of the part members
+            if (groups[g_id].type() == unvpp::GroupType::Element) {
+                unvpp::ElementTypes types;
+                for (auto e_id : groups[g_id].elements_ids()) {
+                    types.insert(local.elements().value()[e_id].type());
+                }
+                EXPECT_EQ(groups[g_id].unique_element_types(), types);
+            }
+        }
+    }
+
+    EXPECT_EQ(n_elements, mesh.elements().value().size());
+    for (std::size_t g_id = 0; g_id < group_sizes.size(); ++g_id) {
+        const auto& group = mesh.groups().value()[g_id];
+        if (group.type() == unvpp::GroupType::Element) {
+            EXPECT_EQ(group_sizes[g_id], group.elements_ids().size());
+        }
+    }
+}
+
+TEST(MeshPartitionTest, SubdomainGroupTypes) {
+    // a hex and a tetra far apart, in a single group
+    std::vector<std::array<double, 3>> vertices{
+        {0., 0., 0.},  {1., 0., 0.},  {1., 1., 0.}, {0., 1., 0.},
+        {0., 0., 1.},  {1., 0., 1.},  {1., 1., 1.}, {0., 1., 1.},
+        {10., 0., 0.}, {11., 0., 0.}, {10., 1., 0.}, {10., 0., 1.}};
+    std::vector<unvpp::Element> elements{
+        unvpp::Element({0, 1, 2, 3, 4, 5, 6, 7}, unvpp::ElementType::Hex),
+        unvpp::Element({8, 9, 10, 11}, unvpp::ElementType::Tetra)};
+    unvpp::Group cells("cells", unvpp::GroupType::Element, unvpp::GroupMembers({0, 1}));
+    cells.add_element_type(unvpp::ElementType::Hex);
+    cells.add_element_type(unvpp::ElementType::Tetra);
+    auto mesh = unvpp::Mesh(vertices, elements, std::vector<unvpp::Group>{cells}, std::nullopt);
+
+    auto parts = unvpp::partition(mesh, 2);
+    ASSERT_NE(parts[0], parts[1]);
+    for (const auto& subdomain : unvpp::extract_subdomains(mesh, parts)) {
+        const auto& group = subdomain.mesh.groups().value().at(0);
+        ASSERT_EQ(group.elements_ids().size(), 1);
+        auto type = subdomain.mesh.elements().value()[0].type();
+        EXPECT_EQ(group.unique_element_types().size(), 1);
+        EXPECT_TRUE(group.unique_element_types().contains(type));
+    }
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <unvpp/quality.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <numeric>
+
+auto histogram_total(const unvpp::Histogram& histogram) -> std::size_t {
+    return std::accumulate(histogram.counts.begin(), histogram.counts.end(), std::size_t{0});
+}
+
+TEST(MeshQualityTest, HexCube) {
+    auto path = std::filesystem::path("../../tests/meshes/eight_hex_cube_with_groups.unv");
+    auto mesh = unvpp::read(path);
+    auto report = unvpp::analyze_quality(mesh);
+
+    const auto& hexes = report.histograms[static_cast<std::size_t>(unvpp::ElementType::Hex)];
+    for (const auto& histogram : hexes) {
+        EXPECT_EQ(histogram.count, 8);
+        EXPECT_EQ(histogram_total(histogram), 8);
+    }
+
+    // cubes are perfect elements
+    auto metric = [&](unvpp::QualityMetric m) -> const unvpp::Histogram& {
+        return hexes[static_cast<std::size_t>(m)];
+    };
+    EXPECT_NEAR(metric(unvpp::QualityMetric::AspectRatio).max, 1., 1e-12);
+    EXPECT_NEAR(metric(unvpp::QualityMetric::Skewness).max, 0., 1e-12);
+    EXPECT_NEAR(metric(unvpp::QualityMetric::NonOrthogonality).max, 0., 1e-6);
+    EXPECT_NEAR(metric(unvpp::QualityMetric::MinJacobian).min, 1., 1e-12);
+    EXPECT_EQ(report.negative_volumes[static_cast<std::size_t>(unvpp::ElementType::Hex)], 0);
+}
+
+TEST(MeshQualityTest, WorstElements) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto report = unvpp::analyze_quality(mesh, unvpp::QualityOptions{5});
+
+    const auto& tetras = report.histograms[static_cast<std::size_t>(unvpp::ElementType::Tetra)];
+    EXPECT_EQ(tetras[static_cast<std::size_t>(unvpp::QualityMetric::AspectRatio)].count, 15217);
+    EXPECT_EQ(report.negative_volumes[static_cast<std::size_t>(unvpp::ElementType::Tetra)], 0);
+    EXPECT_EQ(report.negative_volumes[static_cast<std::size_t>(unvpp::ElementType::Wedge)], 0);
+
+    const auto& worst = report.worst[static_cast<std::size_t>(unvpp::QualityMetric::AspectRatio)];
+    ASSERT_EQ(worst.size(), 5);
+    for (std::size_t i = 1; i < worst.size(); ++i) {
+        EXPECT_GE(worst[i - 1].value, worst[i].value);
+    }
+
+    double max_ratio = 0.;
+    for (const auto& type_histograms : report.histograms) {
+        const auto& histogram = type_histograms[static_cast<std::size_t>(unvpp::QualityMetric::AspectRatio)];
+        if (histogram.count > 0) {
+            max_ratio = std::max(max_ratio, histogram.max);
+        }
+    }
+    EXPECT_DOUBLE_EQ(worst[0].value, max_ratio);
+}
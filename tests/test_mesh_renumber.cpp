@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <algorithm>
+#include <filesystem>
+
+auto vertex_bandwidth(const unvpp::Mesh& mesh) -> std::size_t {
+    std::size_t bandwidth = 0;
+    for (const auto& element : mesh.elements().value()) {
+        const auto& ids = element.vertices_ids();
+        auto [low, high] = std::minmax_element(ids.begin(), ids.end());
+        bandwidth = std::max(bandwidth, *high - *low);
+    }
+    return bandwidth;
+}
+
+void expect_same_mesh(const unvpp::Mesh& original,
+                      const unvpp::Mesh& renumbered,
+                      const unvpp::Permutation& permutation) {
+    const auto& elements = original.elements().value();
+    const auto& new_elements = renumbered.elements().value();
+    ASSERT_EQ(new_elements.size(), elements.size());
+
+    for (std::size_t v_id = 0; v_id < renumbered.vertices().size(); ++v_id) {
+        EXPECT_EQ(renumbered.vertices()[v_id],
+                  original.vertices()[permutation.vertices[v_id]]);
+    }
+
+    for (std::size_t e_id = 0; e_id < new_elements.size(); ++e_id) {
+        const auto& element = elements[permutation.elements[e_id]];
+        const auto& new_element = new_elements[e_id];
+        ASSERT_EQ(new_element.type(), element.type());
+        ASSERT_EQ(new_element.vertices_ids().size(), element.vertices_ids().size());
+
+        for (std::size_t i = 0; i < element.vertices_ids().size(); ++i) {
+            EXPECT_EQ(renumbered.vertices()[new_element.vertices_ids()[i]],
+                      original.vertices()[element.vertices_ids()[i]]);
+        }
+    }
+
+    const auto& groups = original.groups().value();
+    const auto& new_groups = renumbered.groups().value();
+    ASSERT_EQ(new_groups.size(), groups.size());
+
+    for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+        const auto& ids = groups[g_id].elements_ids();
+        const auto& new_ids = new_groups[g_id].elements_ids();
+        ASSERT_EQ(new_ids.size(), ids.size());
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (groups[g_id].type() == unvpp::GroupType::Element) {
+                EXPECT_EQ(permutation.elements[new_ids[i]], ids[i]);
+            } else {
+                EXPECT_EQ(permutation.vertices[new_ids[i]], ids[i]);
+            }
+        }
+    }
+}
+
+TEST(MeshRenumberTest, ReverseCuthillMcKee) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto original = unvpp::read(path);
+    auto mesh = original;
+
+    auto permutation = mesh.renumber(unvpp::Ordering::ReverseCuthillMcKee);
+    expect_same_mesh(original, mesh, permutation);
+
+    EXPECT_LT(vertex_bandwidth(mesh), vertex_bandwidth(original));
+}
+
+TEST(MeshRenumberTest, SpaceFillingCurves) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto original = unvpp::read(path);
+
+    for (auto ordering : {unvpp::Ordering::Hilbert, unvpp::Ordering::Morton}) {
+        auto mesh = original;
+        auto permutation = mesh.renumber(ordering);
+        expect_same_mesh(original, mesh, permutation);
+    }
+}
+
+TEST(MeshRenumberTest, InvalidPermutation) {
+    auto path = std::filesystem::path("../../tests/meshes/one_hex_cell.unv");
+    auto mesh = unvpp::read(path);
+
+    auto permutation = unvpp::Permutation{{0, 1, 2}, {}};
+    EXPECT_THROW(mesh.permute(permutation), std::runtime_error);
+}
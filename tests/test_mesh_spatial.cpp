@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <unvpp/spatial.h>
+#include <unvpp/unvpp.h>
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+
+auto squared_distance(const std::array<double, 3>& a, const std::array<double, 3>& b)
+    -> double {
+    return (a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) +
+           (a[2] - b[2]) * (a[2] - b[2]);
+}
+
+auto element_centroid(const unvpp::Mesh& mesh, const unvpp::Element& element)
+    -> std::array<double, 3> {
+    std::array<double, 3> centroid{0., 0., 0.};
+    for (auto v_id : element.vertices_ids()) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            centroid[axis] += mesh.vertices()[v_id][axis];
+        }
+    }
+    for (auto& x : centroid) {
+        x /= static_cast<double>(element.vertices_ids().size());
+    }
+    return centroid;
+}
+
+TEST(SpatialIndexTest, NearestVertices) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto index = unvpp::SpatialIndex(mesh);
+    const auto& vertices = mesh.vertices();
+
+    // every vertex is its own nearest vertex
+    for (std::size_t v_id = 0; v_id < vertices.size(); v_id += 7) {
+        EXPECT_EQ(index.nearest_vertex(vertices[v_id]), v_id);
+    }
+
+    // compare batched k-nearest queries against brute force
+    std::vector<std::array<double, 3>> points;
+    for (std::size_t e_id = 0; e_id < mesh.elements().value().size(); e_id += 97) {
+        points.push_back(element_centroid(mesh, mesh.elements().value()[e_id]));
+    }
+
+    constexpr std::size_t k = 5;
+    auto nearest = index.nearest_vertices(points, k);
+    ASSERT_EQ(nearest.size(), points.size() * k);
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        std::vector<std::size_t> order(vertices.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [&](auto lhs, auto rhs) {
+                              auto d_lhs = squared_distance(points[i], vertices[lhs]);
+                              auto d_rhs = squared_distance(points[i], vertices[rhs]);
+                              return d_lhs < d_rhs || (d_lhs == d_rhs && lhs < rhs);
+                          });
+        for (std::size_t j = 0; j < k; ++j) {
+            EXPECT_EQ(nearest[i * k + j], order[j]);
+        }
+    }
+}
+
+TEST(SpatialIndexTest, LocatePoints) {
+    auto path = std::filesystem::path("../../tests/meshes/eight_hex_cube_with_groups.unv");
+    auto mesh = unvpp::read(path);
+    auto index = unvpp::SpatialIndex(mesh);
+    const auto& elements = mesh.elements().value();
+
+    std::vector<std::array<double, 3>> points;
+    std::vector<std::size_t> expected;
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        if (elements[e_id].type() == unvpp::ElementType::Hex) {
+            points.push_back(element_centroid(mesh, elements[e_id]));
+            expected.push_back(e_id);
+        }
+    }
+    ASSERT_EQ(points.size(), 8);
+
+    auto cells = index.locate(points);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ASSERT_TRUE(cells[i].has_value());
+        EXPECT_EQ(cells[i].value(), expected[i]);
+    }
+
+    EXPECT_FALSE(index.locate({10., 10., 10.}).has_value());
+}
+
+TEST(SpatialIndexTest, LocateMixedCells) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto index = unvpp::SpatialIndex(mesh);
+    const auto& elements = mesh.elements().value();
+
+    // centroids of tetrahedra and wedges are strictly inside their own cell
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        auto type = elements[e_id].type();
+        if (type == unvpp::ElementType::Tetra || type == unvpp::ElementType::Wedge) {
+            auto cell = index.locate(element_centroid(mesh, elements[e_id]));
+            ASSERT_TRUE(cell.has_value());
+            EXPECT_EQ(cell.value(), e_id);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <unvpp/vtu.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct VtuFile {
+    std::string header;
+    std::string appended;
+};
+
+auto read_vtu(const std::filesystem::path& path) -> VtuFile {
+    std::ifstream file(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto start = content.find('_', content.find("<AppendedData")) + 1;
+    return {content.substr(0, start), content.substr(start)};
+}
+
+auto array_offsets(const std::string& header) -> std::vector<std::size_t> {
+    std::vector<std::size_t> offsets;
+    for (auto pos = header.find("offset=\""); pos != std::string::npos;
+         pos = header.find("offset=\"", pos + 1)) {
+        offsets.push_back(std::stoull(header.substr(pos + 8)));
+    }
+    return offsets;
+}
+
+template <typename T>
+auto raw_array(const std::string& appended, std::size_t offset) -> std::vector<T> {
+    std::uint64_t n_bytes{};
+    std::memcpy(&n_bytes, appended.data() + offset, sizeof(n_bytes));
+    std::vector<T> values(n_bytes / sizeof(T));
+    std::memcpy(values.data(), appended.data() + offset + sizeof(n_bytes), n_bytes);
+    return values;
+}
+
+TEST(MeshVtuTest, OneHexCell) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/one_hex_cell.unv"));
+    auto path = std::filesystem::temp_directory_path() / "unvpp_one_hex_cell.vtu";
+    unvpp::write_vtu(mesh, path);
+
+    auto vtu = read_vtu(path);
+    EXPECT_NE(vtu.header.find("NumberOfPoints=\"8\""), std::string::npos);
+    auto offsets = array_offsets(vtu.header);
+
+    // points, connectivity, offsets and types, after the groups arrays
+    ASSERT_GE(offsets.size(), 4);
+    auto n = offsets.size();
+    auto points = raw_array<std::array<double, 3>>(vtu.appended, offsets[n - 4]);
+    EXPECT_EQ(points, mesh.vertices());
+
+    const auto& elements = mesh.elements().value();
+    auto connectivity = raw_array<std::int64_t>(vtu.appended, offsets[n - 3]);
+    auto cells_offsets = raw_array<std::int64_t>(vtu.appended, offsets[n - 2]);
+    auto types = raw_array<std::uint8_t>(vtu.appended, offsets[n - 1]);
+    ASSERT_EQ(types.size(), elements.size());
+    ASSERT_EQ(cells_offsets.size(), elements.size());
+
+    std::size_t k = 0;
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        const auto& ids = elements[e_id].vertices_ids();
+        EXPECT_EQ(cells_offsets[e_id], static_cast<std::int64_t>(k + ids.size()));
+        if (elements[e_id].type() == unvpp::ElementType::Hex) {
+            EXPECT_EQ(types[e_id], 12);
+            for (auto id : ids) {
+                EXPECT_EQ(connectivity[k++], static_cast<std::int64_t>(id));
+            }
+        } else {
+            k += ids.size();
+        }
+    }
+    EXPECT_EQ(k, connectivity.size());
+    std::filesystem::remove(path);
+}
+
+TEST(MeshVtuTest, GroupsArrays) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv"));
+    auto path = std::filesystem::temp_directory_path() / "unvpp_cylinder.vtu";
+    unvpp::write_vtu(mesh, path);
+
+    auto vtu = read_vtu(path);
+    auto offsets = array_offsets(vtu.header);
+    const auto& groups = mesh.groups().value();
+    ASSERT_EQ(offsets.size(), groups.size() + 4);
+
+    // vertex groups come first, then element groups
+    std::size_t i = 0;
+    for (auto group_type : {unvpp::GroupType::Vertex, unvpp::GroupType::Element}) {
+        for (const auto& group : groups) {
+            if (group.type() != group_type) {
+                continue;
+            }
+            EXPECT_NE(vtu.header.find("Name=\"" + group.name() + "\""), std::string::npos);
+            auto flags = raw_array<std::uint8_t>(vtu.appended, offsets[i++]);
+            std::size_t n_members = 0;
+            for (auto flag : flags) {
+                n_members += flag;
+            }
+            EXPECT_EQ(n_members, group.elements_ids().size());
+        }
+    }
+
+    auto connectivity = raw_array<std::int64_t>(vtu.appended, offsets[i + 1]);
+    auto cells_offsets = raw_array<std::int64_t>(vtu.appended, offsets[i + 2]);
+    EXPECT_EQ(static_cast<std::int64_t>(connectivity.size()), cells_offsets.back());
+    std::filesystem::remove(path);
+}
+
+TEST(MeshVtuTest, Compressed) {
+    auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv"));
+    auto path = std::filesystem::temp_directory_path() / "unvpp_cylinder_zlib.vtu";
+    auto options = unvpp::VtuOptions();
+    options.compression = unvpp::VtuCompression::Zlib;
+
+    try {
+        unvpp::write_vtu(mesh, path, options);
+    } catch (const std::runtime_error&) {
+        GTEST_SKIP() << "unvpp built without zlib";
+    }
+
+    auto vtu = read_vtu(path);
+    EXPECT_NE(vtu.header.find("vtkZLibDataCompressor"), std::string::npos);
+    auto offsets = array_offsets(vtu.header);
+
+    // the points array header: blocks count, block size, last block size
+    std::array<std::uint64_t, 3> header{};
+    std::memcpy(header.data(), vtu.appended.data() + offsets[offsets.size() - 4],
+                sizeof(header));
+    ASSERT_GE(header[0], 1);
+    EXPECT_EQ((header[0] - 1) * header[1] + header[2],
+              mesh.vertices().size() * sizeof(std::array<double, 3>));
+    std::filesystem::remove(path);
+}
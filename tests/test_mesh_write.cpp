@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <numeric>
+#include <vector>
+
+void expect_same_mesh(const unvpp::Mesh& mesh, const unvpp::Mesh& read_back) {
+    EXPECT_EQ(read_back.vertices(), mesh.vertices());
+
+    ASSERT_EQ(read_back.elements().has_value(), mesh.elements().has_value());
+    if (mesh.elements().has_value()) {
+        const auto& elements = mesh.elements().value();
+        const auto& read_elements = read_back.elements().value();
+        ASSERT_EQ(read_elements.size(), elements.size());
+        for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+            EXPECT_EQ(read_elements[e_id].type(), elements[e_id].type());
+            EXPECT_EQ(read_elements[e_id].vertices_ids(), elements[e_id].vertices_ids());
+        }
+    }
+
+    const auto& groups = mesh.groups().value();
+    const auto& read_groups = read_back.groups().value();
+    ASSERT_EQ(read_groups.size(), groups.size());
+    for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+        EXPECT_EQ(read_groups[g_id].name(), groups[g_id].name());
+        EXPECT_EQ(read_groups[g_id].type(), groups[g_id].type());
+        EXPECT_EQ(read_groups[g_id].elements_ids(), groups[g_id].elements_ids());
+    }
+}
+
+TEST(MeshWriteTest, RoundTrip) {
+    auto path = std::filesystem::temp_directory_path() / "unvpp_write_round_trip.unv";
+
+    for (const auto* name : {"one_hex_cell.unv", "eight_hex_cube_with_groups.unv",
+                             "cylinderWithGroupsCoarse.unv"}) {
+        auto mesh = unvpp::read(std::filesystem::path("../../tests/meshes") / name);
+        unvpp::write(path, mesh);
+        auto read_back = unvpp::read(path);
+
+        expect_same_mesh(mesh, read_back);
+        EXPECT_EQ(read_back.unit_system()->code(), mesh.unit_system()->code());
+        EXPECT_EQ(read_back.unit_system()->length_scale(), mesh.unit_system()->length_scale());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MeshWriteTest, ParabolicElements) {
+    // parabolic elements, with vertices ids records spanning several lines
+    std::vector<std::array<double, 3>> vertices(20);
+    for (std::size_t v_id = 0; v_id < vertices.size(); ++v_id) {
+        vertices[v_id] = {0.1 * static_cast<double>(v_id), 1. / 3., -1e-300};
+    }
+
+    auto ids = [](std::size_t n) {
+        std::vector<std::size_t> vertices_ids(n);
+        std::iota(vertices_ids.rbegin(), vertices_ids.rend(), 0);
+        return vertices_ids;
+    };
+
+    std::vector<unvpp::Element> elements{
+        {ids(3), unvpp::ElementType::Line},   {ids(6), unvpp::ElementType::Triangle},
+        {ids(8), unvpp::ElementType::Quad},   {ids(10), unvpp::ElementType::Tetra},
+        {ids(15), unvpp::ElementType::Wedge}, {ids(20), unvpp::ElementType::Hex},
+    };
+    std::vector<unvpp::Group> groups{
+        {"odd vertices", unvpp::GroupType::Vertex, std::vector<std::size_t>{1, 3, 5}},
+        {"cells", unvpp::GroupType::Element, std::vector<std::size_t>{3, 4, 5, 0}},
+    };
+    auto mesh = unvpp::Mesh(vertices, elements, groups, std::nullopt);
+
+    auto path = std::filesystem::temp_directory_path() / "unvpp_write_parabolic.unv";
+    unvpp::write(path, mesh);
+    expect_same_mesh(mesh, unvpp::read(path));
+
+    auto slice = unvpp::read_partition(path, 1, 2);
+    ASSERT_EQ(slice.elements.size(), 3);
+    EXPECT_EQ(slice.elements[2].vertices_ids().size(), 20);
+    std::filesystem::remove(path);
+}
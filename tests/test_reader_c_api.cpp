@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <unvpp/unvpp_c.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST(ReaderCApiTest, Arrays) {
+    auto path = std::string("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto reference = unvpp::read(std::filesystem::path(path));
+
+    unvpp_mesh* mesh = nullptr;
+    ASSERT_EQ(unvpp_read(path.c_str(), &mesh), UNVPP_OK);
+    ASSERT_NE(mesh, nullptr);
+
+    std::size_t length = 0;
+    const auto* vertices = unvpp_vertices(mesh, &length);
+    ASSERT_EQ(unvpp_vertices_count(mesh), reference.vertices().size());
+    ASSERT_EQ(length, 3 * reference.vertices().size());
+    for (std::size_t v_id = 0; v_id < reference.vertices().size(); ++v_id) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            EXPECT_EQ(vertices[3 * v_id + axis], reference.vertices()[v_id][axis]);
+        }
+    }
+
+    // accessors return the same buffers, not copies
+    EXPECT_EQ(unvpp_vertices(mesh, nullptr), vertices);
+
+    const auto& elements = reference.elements().value();
+    std::size_t n_types = 0;
+    std::size_t n_offsets = 0;
+    std::size_t n_ids = 0;
+    const auto* types = unvpp_elements_types(mesh, &n_types);
+    const auto* offsets = unvpp_elements_offsets(mesh, &n_offsets);
+    const auto* ids = unvpp_elements_vertices_ids(mesh, &n_ids);
+    ASSERT_EQ(unvpp_elements_count(mesh), elements.size());
+    ASSERT_EQ(n_types, elements.size());
+    ASSERT_EQ(n_offsets, elements.size() + 1);
+    ASSERT_EQ(offsets[elements.size()], n_ids);
+
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        EXPECT_EQ(types[e_id], static_cast<std::uint8_t>(elements[e_id].type()));
+        const auto& vertices_ids = elements[e_id].vertices_ids();
+        ASSERT_EQ(offsets[e_id + 1] - offsets[e_id], vertices_ids.size());
+        for (std::size_t i = 0; i < vertices_ids.size(); ++i) {
+            EXPECT_EQ(ids[offsets[e_id] + i], vertices_ids[i]);
+        }
+    }
+
+    const auto& groups = reference.groups().value();
+    ASSERT_EQ(unvpp_groups_count(mesh), groups.size());
+    for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+        EXPECT_EQ(std::string(unvpp_group_name(mesh, g_id)), groups[g_id].name());
+
+        unvpp_group_kind type{};
+        ASSERT_EQ(unvpp_group_type(mesh, g_id, &type), UNVPP_OK);
+        EXPECT_EQ(type == UNVPP_VERTEX_GROUP, groups[g_id].type() == unvpp::GroupType::Vertex);
+
+        const auto* members = unvpp_group_members(mesh, g_id, &length);
+        ASSERT_EQ(length, groups[g_id].elements_ids().size());
+        for (std::size_t i = 0; i < length; ++i) {
+            EXPECT_EQ(members[i], groups[g_id].elements_ids()[i]);
+        }
+    }
+
+    std::size_t code = 0;
+    double length_scale = 0.;
+    ASSERT_EQ(unvpp_units(mesh, &code, &length_scale), UNVPP_OK);
+    EXPECT_EQ(code, reference.unit_system()->code());
+    EXPECT_EQ(length_scale, reference.unit_system()->length_scale());
+
+    unvpp_free(mesh);
+}
+
+TEST(ReaderCApiTest, Errors) {
+    unvpp_mesh* mesh = nullptr;
+    EXPECT_EQ(unvpp_read("../../tests/meshes/missing.unv", &mesh), UNVPP_ERROR);
+    EXPECT_EQ(mesh, nullptr);
+    EXPECT_NE(std::string(unvpp_last_error()), "");
+
+    EXPECT_EQ(unvpp_read(nullptr, &mesh), UNVPP_INVALID_ARGUMENT);
+
+    ASSERT_EQ(unvpp_read("../../tests/meshes/one_hex_cell.unv", &mesh), UNVPP_OK);
+    std::size_t length = 1;
+    EXPECT_EQ(unvpp_group_members(mesh, 100, &length), nullptr);
+    EXPECT_EQ(length, 0);
+    EXPECT_EQ(unvpp_group_name(mesh, 100), nullptr);
+    EXPECT_EQ(unvpp_vertices(nullptr, &length), nullptr);
+    unvpp_free(mesh);
+    unvpp_free(nullptr);
+}
+
+TEST(ReaderCApiTest, Options) {
+    auto path = std::string("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    unvpp::ReadOptions si;
+    si.si_units = true;
+    auto reference = unvpp::read(std::filesystem::path(path), si);
+
+    unvpp_read_options options{};
+    options.si_units = 1;
+    unvpp_mesh* mesh = nullptr;
+    ASSERT_EQ(unvpp_read_with_options(path.c_str(), &options, &mesh), UNVPP_OK);
+    const auto* vertices = unvpp_vertices(mesh, nullptr);
+    ASSERT_EQ(unvpp_vertices_count(mesh), reference.vertices().size());
+    for (std::size_t v_id = 0; v_id < reference.vertices().size(); ++v_id) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            EXPECT_EQ(vertices[3 * v_id + axis], reference.vertices()[v_id][axis]);
+        }
+    }
+    std::size_t code = 0;
+    double length_scale = 0.;
+    ASSERT_EQ(unvpp_units(mesh, &code, &length_scale), UNVPP_OK);
+    EXPECT_EQ(code, 1);
+    EXPECT_EQ(length_scale, 1.);
+    unvpp_free(mesh);
+
+    // a duplicate vertex id is only rejected by strict reads
+    auto invalid = std::filesystem::temp_directory_path() / "unvpp_c_api_duplicate.unv";
+    {
+        std::ifstream input("../../tests/meshes/one_hex_cell.unv");
+        std::ofstream output(invalid);
+        std::string line;
+        for (std::size_t n = 1; std::getline(input, line); ++n) {
+            output << (n == 22 ? "         1         1         1        11" : line) << '\n';
+        }
+    }
+    ASSERT_EQ(unvpp_read_with_options(invalid.c_str(), nullptr, &mesh), UNVPP_OK);
+    unvpp_free(mesh);
+
+    options = unvpp_read_options{};
+    options.strict = 1;
+    EXPECT_EQ(unvpp_read_with_options(invalid.c_str(), &options, &mesh), UNVPP_ERROR);
+    EXPECT_EQ(mesh, nullptr);
+    EXPECT_NE(std::string(unvpp_last_error()).find("Duplicate vertex id 1"), std::string::npos);
+    EXPECT_EQ(unvpp_read_with_options(nullptr, &options, &mesh), UNVPP_INVALID_ARGUMENT);
+    std::filesystem::remove(invalid);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <unvpp/compact.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+
+template <typename Index, typename Real>
+void expect_same_mesh(const unvpp::Mesh& mesh, const unvpp::CompactMesh<Index, Real>& compact) {
+    ASSERT_EQ(compact.vertices.size(), mesh.vertices().size());
+    for (std::size_t v_id = 0; v_id < mesh.vertices().size(); ++v_id) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            EXPECT_EQ(compact.vertices[v_id][axis],
+                      static_cast<Real>(mesh.vertices()[v_id][axis]));
+        }
+    }
+
+    const auto& elements = mesh.elements().value();
+    ASSERT_EQ(compact.elements_count(), elements.size());
+    ASSERT_EQ(compact.elements_offsets.size(), elements.size() + 1);
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        EXPECT_EQ(compact.elements_types[e_id], elements[e_id].type());
+        const auto& ids = elements[e_id].vertices_ids();
+        ASSERT_EQ(compact.elements_offsets[e_id + 1] - compact.elements_offsets[e_id],
+                  ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(compact.elements_vertices_ids[compact.elements_offsets[e_id] + i], ids[i]);
+        }
+    }
+
+    const auto& groups = mesh.groups().value();
+    ASSERT_EQ(compact.groups.size(), groups.size());
+    for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+        EXPECT_EQ(compact.groups[g_id].name, groups[g_id].name());
+        EXPECT_EQ(compact.groups[g_id].type, groups[g_id].type());
+        ASSERT_EQ(compact.groups[g_id].ids.size(), groups[g_id].elements_ids().size());
+        for (std::size_t i = 0; i < compact.groups[g_id].ids.size(); ++i) {
+            EXPECT_EQ(compact.groups[g_id].ids[i], groups[g_id].elements_ids()[i]);
+        }
+    }
+    EXPECT_EQ(compact.unit_system.has_value(), mesh.unit_system().has_value());
+}
+
+TEST(ReaderCompactTest, ReadCompact) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+
+    expect_same_mesh(mesh, unvpp::read_compact(path));
+    expect_same_mesh(mesh, unvpp::read_compact<std::uint64_t, double>(path));
+    expect_same_mesh(mesh, unvpp::to_compact<std::uint32_t, double>(mesh));
+}
+
+TEST(ReaderCompactTest, CoordinateOverflow) {
+    auto mesh = unvpp::Mesh({{0., 0., 1e300}}, std::nullopt, std::nullopt, std::nullopt);
+
+    EXPECT_THROW((unvpp::to_compact<std::uint32_t, float>(mesh)), std::runtime_error);
+    EXPECT_NO_THROW((unvpp::to_compact<std::uint32_t, double>(mesh)));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <unvpp/datasets.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const auto one_hex_path = std::filesystem::path("../../tests/meshes/one_hex_cell.unv");
+
+auto file_content(const std::filesystem::path& path) -> std::string {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+// one hex cell mesh with a large dataset 18 spanning many read blocks, ending
+// without a final line break
+auto write_large_dataset_file(const std::filesystem::path& path, std::size_t n_lines) {
+    auto mesh = file_content(one_hex_path);
+    auto coordinates = mesh.find("    -1\n  2420");
+    auto tail = mesh.substr(coordinates);
+
+    std::ofstream file(path);
+    file << "    -1\n    18\n";
+    for (std::size_t i = 0; i < n_lines; ++i) {
+        file << "     -1 line " << i << '\n';
+    }
+    file << "    -1\n";
+    file << mesh.substr(0, coordinates);
+    tail.pop_back();
+    file << tail;
+}
+
+} // namespace
+
+TEST(ReaderDatasetsTest, HandlerLines) {
+    unvpp::DatasetRegistry registry;
+    std::vector<std::string> lines;
+    registry.add(2420, [&](std::size_t dataset, const std::vector<std::string_view>& views) {
+        EXPECT_EQ(dataset, 2420);
+        lines.assign(views.begin(), views.end());
+    });
+
+    auto mesh = unvpp::read(one_hex_path, unvpp::ReadOptions{nullptr, &registry});
+    ASSERT_EQ(lines.size(), 8);
+    EXPECT_EQ(lines[0], "         1");
+    EXPECT_EQ(lines[1], "SMESH_Mesh");
+    EXPECT_EQ(lines[3], "Global Cartesian Coordinate System");
+
+    auto expected = unvpp::read(one_hex_path);
+    EXPECT_EQ(mesh.vertices(), expected.vertices());
+    EXPECT_EQ(mesh.elements()->size(), expected.elements()->size());
+}
+
+TEST(ReaderDatasetsTest, SkipLargeDatasets) {
+    auto path = std::filesystem::temp_directory_path() / "unvpp_large_dataset.unv";
+    constexpr std::size_t n_lines = 20000;
+    write_large_dataset_file(path, n_lines);
+
+    unvpp::DatasetRegistry registry;
+    std::vector<std::string> lines;
+    std::size_t n_coordinate_lines{0};
+    registry.add(18, [&](std::size_t, const std::vector<std::string_view>& views) {
+        lines.assign(views.begin(), views.end());
+    });
+    registry.add(2420, [&](std::size_t, const std::vector<std::string_view>& views) {
+        n_coordinate_lines += views.size();
+    });
+
+    auto mesh = unvpp::read(path, unvpp::ReadOptions{nullptr, &registry});
+    ASSERT_EQ(lines.size(), n_lines);
+    // lines which are not separators are kept, whatever their indentation
+    EXPECT_EQ(lines.front(), "     -1 line 0");
+    EXPECT_EQ(lines.back(), "     -1 line " + std::to_string(n_lines - 1));
+    EXPECT_EQ(n_coordinate_lines, 8);
+
+    auto skipped = unvpp::read(path);
+    auto expected = unvpp::read(one_hex_path);
+    for (const auto* read_mesh : {&mesh, &skipped}) {
+        EXPECT_EQ(read_mesh->vertices(), expected.vertices());
+        ASSERT_TRUE(read_mesh->elements().has_value());
+        EXPECT_EQ(read_mesh->elements()->size(), expected.elements()->size());
+        EXPECT_EQ(read_mesh->unit_system()->code(), expected.unit_system()->code());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(ReaderDatasetsTest, Errors) {
+    unvpp::DatasetRegistry registry;
+    EXPECT_THROW(registry.add(2411, [](std::size_t, const std::vector<std::string_view>&) {}),
+                 std::runtime_error);
+    EXPECT_THROW(registry.add(2420, unvpp::DatasetHandler()), std::runtime_error);
+
+    // handlers errors reach the caller
+    registry.add(2420, [](std::size_t, const std::vector<std::string_view>&) {
+        throw std::runtime_error("bad coordinate system");
+    });
+    EXPECT_THROW(unvpp::read(one_hex_path, unvpp::ReadOptions{nullptr, &registry}), std::runtime_error);
+
+    registry.remove(2420);
+    EXPECT_TRUE(registry.empty());
+    EXPECT_NO_THROW(unvpp::read(one_hex_path, unvpp::ReadOptions{nullptr, &registry}));
+}
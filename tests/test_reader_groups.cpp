@@ -31,4 +31,51 @@ TEST(ReaderGroupsTest, GroupsNames) {
     EXPECT_EQ(groups[1].name(), "inout");
     EXPECT_EQ(groups[1].elements_ids().size(), 8);
     EXPECT_EQ(groups[1].unique_element_types().size(), 1);
-}
\ No newline at end of file
+}
+
+TEST(ReaderGroupsTest, GroupsRanges) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    const auto& elements = mesh.elements().value();
+
+    for (const auto& group : mesh.groups().value()) {
+        const auto& members = group.elements_ids();
+        EXPECT_LE(members.ranges().size(), members.size());
+
+        std::size_t i = 0;
+        for (auto id : members) {
+            EXPECT_EQ(members[i++], id);
+            EXPECT_TRUE(members.contains(id));
+            if (group.type() == unvpp::GroupType::Element) {
+                EXPECT_TRUE(group.unique_element_types().contains(elements[id].type()));
+            }
+        }
+        EXPECT_EQ(i, members.size());
+    }
+}
+
+TEST(ReaderGroupsTest, GroupMembers) {
+    auto members = unvpp::GroupMembers({4, 5, 6, 7, 10, 11, 2});
+    ASSERT_EQ(members.size(), 7);
+    ASSERT_EQ(members.ranges().size(), 3);
+    EXPECT_EQ(members.ranges()[0].first, 4);
+    EXPECT_EQ(members.ranges()[0].count, 4);
+    EXPECT_EQ(members[4], 10);
+    EXPECT_EQ(members[6], 2);
+    EXPECT_EQ(members.to_vector(), (std::vector<std::size_t>{4, 5, 6, 7, 10, 11, 2}));
+
+    EXPECT_TRUE(members.contains(2));
+    EXPECT_TRUE(members.contains(11));
+    EXPECT_FALSE(members.contains(8));
+    EXPECT_THROW(members[7], std::runtime_error);
+
+    unvpp::ElementTypes types;
+    types.insert(unvpp::ElementType::Wedge);
+    types.insert(unvpp::ElementType::Line);
+    types.insert(unvpp::ElementType::Wedge);
+    EXPECT_EQ(types.size(), 2);
+    EXPECT_FALSE(types.contains(unvpp::ElementType::Hex));
+    EXPECT_EQ(std::vector<unvpp::ElementType>(types.begin(), types.end()),
+              (std::vector<unvpp::ElementType>{unvpp::ElementType::Line,
+                                               unvpp::ElementType::Wedge}));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+TEST(ReaderLazyTest, SameAsRead) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    auto lazy = unvpp::LazyMesh(path);
+
+    EXPECT_EQ(lazy.unit_system().value().code(), mesh.unit_system().value().code());
+
+    // groups are available before vertices are accessed
+    const auto& groups = lazy.groups().value();
+    ASSERT_EQ(groups.size(), mesh.groups().value().size());
+    for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+        EXPECT_EQ(groups[g_id].name(), mesh.groups().value()[g_id].name());
+        EXPECT_EQ(groups[g_id].elements_ids(), mesh.groups().value()[g_id].elements_ids());
+        EXPECT_EQ(groups[g_id].unique_element_types(),
+                  mesh.groups().value()[g_id].unique_element_types());
+    }
+
+    EXPECT_EQ(lazy.vertices(), mesh.vertices());
+    ASSERT_EQ(lazy.elements().value().size(), mesh.elements().value().size());
+    for (std::size_t e_id = 0; e_id < mesh.elements().value().size(); ++e_id) {
+        EXPECT_EQ(lazy.elements().value()[e_id].vertices_ids(),
+                  mesh.elements().value()[e_id].vertices_ids());
+    }
+}
+
+TEST(ReaderLazyTest, ConcurrentAccess) {
+    auto path = std::filesystem::path("../../tests/meshes/eight_hex_cube_with_groups.unv");
+    auto lazy = unvpp::LazyMesh(path);
+
+    // every thread sees the same, single copy of each dataset
+    std::vector<const void*> elements(8);
+    std::vector<const void*> vertices(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            elements[i] = &lazy.elements().value();
+            vertices[i] = &lazy.vertices();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+        EXPECT_EQ(elements[i], elements[0]);
+        EXPECT_EQ(vertices[i], vertices[0]);
+    }
+    EXPECT_EQ(lazy.elements().value().size(), 56);
+    EXPECT_EQ(lazy.vertices().size(), 27);
+    EXPECT_EQ(lazy.groups().value().size(), 2);
+}
+
+TEST(ReaderLazyTest, GroupsLeaveVerticesAndElementsUnparsed) {
+    // coordinates and connectivity cannot be parsed, only their ids can
+    auto path = std::filesystem::temp_directory_path() / "unvpp_lazy_groups.unv";
+    {
+        std::ofstream file(path);
+        file << "    -1\n  2411\n"
+             << "         1         1         1        11\n  bad  bad  bad\n"
+             << "         2         1         1        11\n  bad  bad  bad\n"
+             << "         3         1         1        11\n  bad  bad  bad\n"
+             << "    -1\n";
+        file << "    -1\n  2412\n"
+             << "        10        41         2         1         7         3\n  x  y  z\n"
+             << "        20        41         2         1         7         3\n  x  y  z\n"
+             << "    -1\n";
+        file << "    -1\n  2467\n"
+             << "         1         0         0         0         0         0         0         2\nfaces\n"
+             << "         8        20         0         0         8        10         0         0\n"
+             << "         2         0         0         0         0         0         0         1\npoints\n"
+             << "         7         3         0         0\n"
+             << "    -1\n";
+    }
+
+    auto lazy = unvpp::LazyMesh(path);
+    const auto& groups = lazy.groups().value();
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(groups[0].name(), "faces");
+    EXPECT_EQ(groups[0].elements_ids().to_vector(), std::vector<std::size_t>({1, 0}));
+    EXPECT_TRUE(groups[0].unique_element_types().contains(unvpp::ElementType::Triangle));
+    EXPECT_EQ(groups[1].type(), unvpp::GroupType::Vertex);
+    EXPECT_EQ(groups[1].elements_ids().to_vector(), std::vector<std::size_t>({2}));
+
+    EXPECT_THROW(lazy.vertices(), std::runtime_error);
+    EXPECT_THROW(lazy.elements(), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
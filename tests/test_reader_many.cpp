@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+
+TEST(ReaderManyTest, ResultsInInputOrder) {
+    std::vector<std::filesystem::path> paths{
+        "../../tests/meshes/one_hex_cell.unv",
+        "../../tests/meshes/cylinderWithGroupsCoarse.unv",
+        "../../tests/meshes/does_not_exist.unv",
+        "../../tests/meshes/eight_hex_cube_with_groups.unv",
+    };
+
+    // a one byte budget forces files to be read one at a time
+    for (auto max_bytes : {std::size_t{0}, std::size_t{1}}) {
+        unvpp::BatchOptions options;
+        options.n_threads = 3;
+        options.max_bytes_in_flight = max_bytes;
+
+        auto results = unvpp::read_many(paths, options);
+        ASSERT_EQ(results.size(), paths.size());
+
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            EXPECT_EQ(results[i].path, paths[i]);
+        }
+
+        ASSERT_TRUE(results[0].mesh.has_value());
+        EXPECT_EQ(results[0].mesh->vertices().size(), 8);
+        ASSERT_TRUE(results[1].mesh.has_value());
+        EXPECT_EQ(results[1].mesh->vertices().size(), 5207);
+        EXPECT_FALSE(results[2].mesh.has_value());
+        EXPECT_FALSE(results[2].error.empty());
+        ASSERT_TRUE(results[3].mesh.has_value());
+        EXPECT_EQ(results[3].mesh->elements()->size(), 56);
+    }
+}
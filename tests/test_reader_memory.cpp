@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+
+// global allocations of the test binary are tracked, with their size stored
+// in front of each block
+namespace {
+
+constexpr std::size_t header_size = alignof(std::max_align_t);
+
+std::atomic<std::size_t> allocated_bytes{0};
+std::atomic<std::size_t> peak_bytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    auto* block = static_cast<char*>(std::malloc(size + header_size));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    auto current = allocated_bytes.fetch_add(size) + size;
+    auto peak = peak_bytes.load();
+    while (current > peak && !peak_bytes.compare_exchange_weak(peak, current)) {
+    }
+    return block + header_size;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto* block = static_cast<char*>(pointer) - header_size;
+    allocated_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    operator delete(pointer);
+}
+
+TEST(ReaderMemoryTest, PeakMemory) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+
+    auto baseline = allocated_bytes.load();
+    peak_bytes = baseline;
+    auto mesh = unvpp::read(path);
+    auto mesh_bytes = allocated_bytes.load() - baseline;
+    auto peak = peak_bytes.load() - baseline;
+
+    // arrays are allocated once and moved into the mesh, the remaining
+    // overhead being the elements ids map, as their UNV ids are not
+    // consecutive in this file
+    ASSERT_GT(mesh.vertices().size(), 0);
+    EXPECT_LT(static_cast<double>(peak), 1.6 * static_cast<double>(mesh_bytes));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <unordered_map>
+
+TEST(ReaderPartitionTest, SlicesCoverMesh) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    auto mesh = unvpp::read(path);
+    const auto& elements = mesh.elements().value();
+    const auto& groups = mesh.groups().value();
+
+    for (std::size_t n_ranks : {1, 3, 4}) {
+        std::vector<unvpp::MeshSlice> slices;
+        for (std::size_t rank = 0; rank < n_ranks; ++rank) {
+            slices.push_back(unvpp::read_partition(path, rank, n_ranks));
+        }
+
+        // slices are contiguous, so concatenating them gives the full mesh
+        std::unordered_map<std::size_t, std::size_t> vertex_index;
+        std::size_t n_vertices = 0;
+        for (const auto& slice : slices) {
+            ASSERT_EQ(slice.vertices.size(), slice.vertices_unv_ids.size());
+            for (std::size_t i = 0; i < slice.vertices.size(); ++i) {
+                EXPECT_EQ(slice.vertices[i], mesh.vertices()[n_vertices]);
+                vertex_index[slice.vertices_unv_ids[i]] = n_vertices++;
+            }
+        }
+        EXPECT_EQ(n_vertices, mesh.vertices().size());
+
+        std::size_t n_elements = 0;
+        std::vector<std::size_t> group_sizes(groups.size(), 0);
+        for (const auto& slice : slices) {
+            ASSERT_EQ(slice.elements.size(), slice.elements_unv_ids.size());
+            for (const auto& element : slice.elements) {
+                const auto& expected = elements[n_elements++];
+                ASSERT_EQ(element.type(), expected.type());
+                for (std::size_t i = 0; i < element.vertices_ids().size(); ++i) {
+                    EXPECT_EQ(vertex_index[element.vertices_ids()[i]],
+                              expected.vertices_ids()[i]);
+                }
+            }
+
+            ASSERT_EQ(slice.groups.size(), groups.size());
+            for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+                group_sizes[g_id] += slice.groups[g_id].elements_ids().size();
+            }
+        }
+        EXPECT_EQ(n_elements, elements.size());
+
+        for (std::size_t g_id = 0; g_id < groups.size(); ++g_id) {
+            EXPECT_EQ(group_sizes[g_id], groups[g_id].elements_ids().size());
+        }
+    }
+
+    EXPECT_THROW(unvpp::read_partition(path, 2, 2), std::runtime_error);
+}
@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <unvpp/executor.h>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+
+constexpr std::uintptr_t huge_page_size = std::uintptr_t{1} << 21;
+
+thread_local bool in_worker = false;
+
+// first CPU of each NUMA node with CPUs, as listed by sysfs
+auto nodes_first_cpus() -> std::vector<std::pair<int, int>> {
+    std::vector<std::pair<int, int>> nodes;
+    for (int node = 0; node < 1024; ++node) {
+        std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        int cpu = -1;
+        if (cpulist >> cpu && cpu >= 0) {
+            nodes.emplace_back(node, cpu);
+        }
+    }
+    return nodes;
+}
+
+// executor running task i on worker i % n at every call, each worker pinned
+// to one CPU, so that task i always runs on the same node
+class PinnedExecutor final : public unvpp::Executor {
+public:
+    explicit PinnedExecutor(const std::vector<int>& cpus) : _n_workers(cpus.size()) {
+        for (std::size_t worker = 0; worker < _n_workers; ++worker) {
+            _workers.emplace_back([this, worker, cpu = cpus[worker]]() {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                sched_setaffinity(0, sizeof(set), &set);
+                run(worker);
+            });
+        }
+    }
+
+    ~PinnedExecutor() override {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _start.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    void parallel_for(std::size_t n_tasks, const std::function<void(std::size_t)>& task) override {
+        // nested loops run on the worker calling them
+        if (in_worker) {
+            for (std::size_t i = 0; i < n_tasks; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _task = &task;
+        _n_tasks = n_tasks;
+        _pending = _n_workers;
+        ++_generation;
+        _start.notify_all();
+        _done.wait(lock, [this]() { return _pending == 0; });
+    }
+
+    auto concurrency() const noexcept -> std::size_t override { return _n_workers; }
+
+private:
+    void run(std::size_t worker) {
+        in_worker = true;
+        std::size_t generation = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _start.wait(lock, [&]() { return _stop || _generation != generation; });
+            if (_stop) {
+                return;
+            }
+            generation = _generation;
+            const auto* task = _task;
+            auto n_tasks = _n_tasks;
+
+            lock.unlock();
+            for (auto i = worker; i < n_tasks; i += _n_workers) {
+                (*task)(i);
+            }
+            lock.lock();
+
+            if (--_pending == 0) {
+                _done.notify_all();
+            }
+        }
+    }
+
+    std::size_t _n_workers;
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const std::function<void(std::size_t)>* _task{nullptr};
+    std::size_t _n_tasks{0};
+    std::size_t _pending{0};
+    std::size_t _generation{0};
+    bool _stop{false};
+};
+
+// blocks touched by each task, see unvpp::MemoryPlacement
+auto block_bounds(std::uintptr_t begin, std::uintptr_t end, std::size_t n_tasks)
+    -> std::vector<std::uintptr_t> {
+    auto n_blocks = std::clamp<std::size_t>((end - begin) / huge_page_size, 1, n_tasks);
+    std::vector<std::uintptr_t> bounds{begin};
+    for (std::size_t block = 1; block < n_blocks; ++block) {
+        auto bound = begin + (end - begin) * block / n_blocks;
+        bound = (bound + huge_page_size - 1) & ~(huge_page_size - 1);
+        bounds.push_back(std::clamp(bound, bounds.back(), end));
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+// NUMA node of each page lying entirely in [begin, end), as reported by
+// move_pages
+auto pages_nodes(std::uintptr_t begin, std::uintptr_t end) -> std::optional<std::vector<int>> {
+    auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::vector<void*> pages;
+    for (auto address = (begin + page_size - 1) & ~(page_size - 1); address + page_size <= end;
+         address += page_size) {
+        pages.push_back(reinterpret_cast<void*>(address));
+    }
+    std::vector<int> status(pages.size(), -1);
+    if (!pages.empty() &&
+        syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) {
+        return std::nullopt;
+    }
+    return status;
+}
+
+// check that each block of an array lies on the node of the task touching it
+template <typename T>
+void expect_blocks_on_task_nodes(const std::vector<T>& values, const std::vector<int>& task_nodes) {
+    auto begin = reinterpret_cast<std::uintptr_t>(values.data());
+    auto bounds = block_bounds(begin, begin + values.capacity() * sizeof(T), task_nodes.size());
+    ASSERT_GT(bounds.size(), 2) << "the array fits in a single block";
+
+    for (std::size_t block = 0; block + 1 < bounds.size(); ++block) {
+        auto nodes = pages_nodes(bounds[block], bounds[block + 1]);
+        ASSERT_TRUE(nodes.has_value()) << "move_pages failed";
+        for (auto node : nodes.value()) {
+            EXPECT_EQ(node, task_nodes[block % task_nodes.size()]) << "in block " << block;
+        }
+    }
+}
+
+// mesh of lines large enough for its arrays to span several huge pages
+auto write_lines_file(const std::filesystem::path& path) {
+    constexpr std::size_t n_vertices = 200000;
+    std::vector<std::array<double, 3>> vertices(n_vertices);
+    std::vector<unvpp::Element> elements;
+    elements.reserve(n_vertices - 1);
+    for (std::size_t i = 0; i < n_vertices; ++i) {
+        vertices[i] = {static_cast<double>(i), 0., 0.};
+        if (i + 1 < n_vertices) {
+            elements.emplace_back(std::vector<std::size_t>{i, i + 1}, unvpp::ElementType::Line);
+        }
+    }
+    unvpp::write(path, unvpp::Mesh(std::move(vertices), std::move(elements), std::nullopt, std::nullopt));
+}
+
+#endif
+
+} // namespace
+
+TEST(ReaderPlacementTest, FirstTouchKeepsMesh) {
+    auto path = std::filesystem::path("../../tests/meshes/cylinderWithGroupsCoarse.unv");
+    unvpp::ThreadPool pool(4);
+
+    unvpp::ReadOptions options;
+    options.executor = &pool;
+    options.placement = unvpp::MemoryPlacement::FirstTouch;
+    auto placed = unvpp::read(path, options);
+    auto mesh = unvpp::read(path);
+
+    EXPECT_EQ(placed.vertices(), mesh.vertices());
+    ASSERT_EQ(placed.elements()->size(), mesh.elements()->size());
+    for (std::size_t i = 0; i < mesh.elements()->size(); ++i) {
+        EXPECT_EQ((*placed.elements())[i].type(), (*mesh.elements())[i].type());
+        EXPECT_EQ((*placed.elements())[i].vertices_ids(), (*mesh.elements())[i].vertices_ids());
+    }
+    EXPECT_EQ(placed.fingerprint(), mesh.fingerprint());
+}
+
+TEST(ReaderPlacementTest, BlocksOnTasksNodes) {
+#ifdef __linux__
+    auto nodes = nodes_first_cpus();
+    if (nodes.size() < 2) {
+        GTEST_SKIP() << "placement needs at least two NUMA nodes with CPUs";
+    }
+
+    // one pinned worker per node, so that consecutive tasks alternate nodes
+    std::vector<int> cpus;
+    std::vector<int> task_nodes;
+    for (const auto& [node, cpu] : nodes) {
+        cpus.push_back(cpu);
+        task_nodes.push_back(node);
+    }
+    PinnedExecutor executor(cpus);
+
+    auto path = std::filesystem::temp_directory_path() / "unvpp_placement_lines.unv";
+    write_lines_file(path);
+
+    unvpp::ReadOptions options;
+    options.executor = &executor;
+    options.placement = unvpp::MemoryPlacement::FirstTouch;
+    auto mesh = unvpp::read(path, options);
+    const auto& elements = mesh.elements().value();
+
+    expect_blocks_on_task_nodes(mesh.vertices(), task_nodes);
+    expect_blocks_on_task_nodes(elements, task_nodes);
+
+    // ids are allocated by the task owning their element, but allocator
+    // arenas may hand a thread memory first touched by another one, so most
+    // of them, not all, are expected on that task node
+    auto begin = reinterpret_cast<std::uintptr_t>(elements.data());
+    auto bounds = block_bounds(begin, begin + elements.capacity() * sizeof(elements[0]), task_nodes.size());
+    std::size_t n_local = 0;
+    std::size_t n_pages = 0;
+    for (std::size_t e_id = 0; e_id < elements.size(); ++e_id) {
+        auto address = reinterpret_cast<std::uintptr_t>(&elements[e_id]);
+        auto block = static_cast<std::size_t>(
+            std::upper_bound(bounds.begin(), bounds.end(), address) - bounds.begin() - 1);
+        const auto& ids = elements[e_id].vertices_ids();
+        void* page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(ids.data()) &
+                                             ~static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE) - 1));
+        int node = -1;
+        ASSERT_EQ(syscall(SYS_move_pages, 0, 1, &page, nullptr, &node, 0), 0);
+        n_local += node == task_nodes[block % task_nodes.size()] ? 1 : 0;
+        ++n_pages;
+    }
+    EXPECT_GE(n_local, n_pages * 9 / 10);
+
+    std::filesystem::remove(path);
+#else
+    GTEST_SKIP() << "page placement is only queried on Linux";
+#endif
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <unvpp/results.h>
+#include <unvpp/unvpp.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST(ReaderResultsTest, ReadResults) {
+    auto path = std::filesystem::path("../../tests/meshes/one_hex_cell_results.unv");
+    auto mesh = unvpp::read(path);
+    auto datasets = unvpp::read_results(path);
+
+    // the data at nodes on elements dataset is skipped
+    ASSERT_EQ(datasets.size(), 4);
+
+    const auto& temperature = datasets[0];
+    EXPECT_EQ(temperature.label, 1);
+    EXPECT_EQ(temperature.name, "Temperature");
+    EXPECT_EQ(temperature.location, unvpp::ResultLocation::Vertices);
+    EXPECT_EQ(temperature.analysis_type, 4);
+    EXPECT_DOUBLE_EQ(temperature.real_data.at(0), 0.5);
+    ASSERT_EQ(temperature.components.size(), 1);
+    ASSERT_EQ(temperature.components[0].size(), mesh.vertices().size());
+    for (std::size_t v_id = 0; v_id < 7; ++v_id) {
+        EXPECT_DOUBLE_EQ(temperature.components[0][v_id], 10. * static_cast<double>(v_id + 1));
+    }
+    EXPECT_TRUE(std::isnan(temperature.components[0][7]));
+
+    const auto& displacement = datasets[1];
+    EXPECT_EQ(displacement.location, unvpp::ResultLocation::Elements);
+    ASSERT_EQ(displacement.components.size(), 3);
+    ASSERT_EQ(displacement.components[0].size(), mesh.elements().value().size());
+    EXPECT_DOUBLE_EQ(displacement.components[0][18], 1.5);
+    EXPECT_DOUBLE_EQ(displacement.components[1][18], -2.5);
+    EXPECT_DOUBLE_EQ(displacement.components[2][12], -0.75);
+    EXPECT_TRUE(std::isnan(displacement.components[0][0]));
+
+    for (std::size_t step = 1; step <= 2; ++step) {
+        const auto& pressure = datasets[1 + step];
+        EXPECT_EQ(pressure.name, "Pressure step " + std::to_string(step));
+        EXPECT_EQ(pressure.integer_data.at(1), static_cast<std::int64_t>(step));
+        ASSERT_EQ(pressure.components.size(), 2);
+        for (std::size_t v_id = 0; v_id < 8; ++v_id) {
+            auto expected = static_cast<double>((v_id + 1) * step);
+            EXPECT_DOUBLE_EQ(pressure.components[0][v_id], expected);
+            EXPECT_DOUBLE_EQ(pressure.components[1][v_id], -expected);
+        }
+    }
+}
+
+TEST(ReaderResultsTest, StreamResults) {
+    auto path = std::filesystem::path("../../tests/meshes/one_hex_cell_results.unv");
+
+    std::vector<std::string> names;
+    unvpp::stream_results(path, [&names](unvpp::ResultDataset&& dataset) {
+        names.push_back(dataset.name);
+    });
+
+    EXPECT_EQ(names, (std::vector<std::string>{"Temperature", "Displacement", "Pressure step 1",
+                                               "Pressure step 2"}));
+
+    // results are skipped when reading the mesh
+    auto mesh = unvpp::read(path);
+    EXPECT_EQ(mesh.vertices().size(), 8);
+    EXPECT_EQ(mesh.elements().value().size(), 19);
+}
+
+TEST(ReaderResultsTest, RecordsOfVaryingLengths) {
+    // mesh tags of the results file, followed by element records of 2 then 8 values
+    auto source = std::ifstream("../../tests/meshes/one_hex_cell_results.unv");
+    auto path = std::filesystem::temp_directory_path() / "unvpp_results_lengths.unv";
+    {
+        std::ofstream file(path);
+        std::string line;
+        for (std::size_t i = 0; i < 89 && std::getline(source, line); ++i) {
+            file << line << "\n";
+        }
+        file << "    -1\n  2414\n         4\nStrain\n         2\n"
+             << "NONE\nNONE\nNONE\nNONE\nNONE\n"
+             << "         1         1         4         8         2         8\n"
+             << "         1         0         1         0         0         0         0         0\n"
+             << "         0         0\n"
+             << "  0.0E+00  0.0E+00  0.0E+00  0.0E+00  0.0E+00  0.0E+00\n"
+             << "  0.0E+00  0.0E+00  0.0E+00  0.0E+00  0.0E+00  0.0E+00\n"
+             << "        19         2\n  1.0E+00  2.0E+00\n"
+             << "        13         8\n"
+             << "  1.0E+01  2.0E+01  3.0E+01  4.0E+01  5.0E+01  6.0E+01\n"
+             << "  7.0E+01  8.0E+01\n"
+             << "    -1\n";
+    }
+
+    auto datasets = unvpp::read_results(path);
+    ASSERT_EQ(datasets.size(), 1);
+    const auto& strain = datasets[0];
+    ASSERT_EQ(strain.components.size(), 8);
+    EXPECT_DOUBLE_EQ(strain.components[0][18], 1.);
+    EXPECT_DOUBLE_EQ(strain.components[1][18], 2.);
+    EXPECT_TRUE(std::isnan(strain.components[2][18]));
+    for (std::size_t c = 0; c < 8; ++c) {
+        EXPECT_DOUBLE_EQ(strain.components[c][12], 10. * static_cast<double>(c + 1));
+    }
+
+    std::filesystem::remove(path);
+}
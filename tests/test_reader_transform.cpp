@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// millimeters mesh with vertices in a global, a rotated and translated, a
+// cylindrical and an undefined coordinate system
+auto write_frames_file(const std::filesystem::path& path) {
+    std::ofstream file(path);
+    file << "    -1\n   164\n"
+         << "         5  MM: mm (milli newton)         2\n"
+         << "    1.0000000000000000E+3    1.0000000000000000E+0    1.0000000000000000E+0\n"
+         << "    2.7314999999999998E+2\n"
+         << "    -1\n";
+    file << "    -1\n  2420\n         1\nPART\n"
+         << "         1         0         0\nGlobal\n"
+         << "  1.0E+0  0.0E+0  0.0E+0\n  0.0E+0  1.0E+0  0.0E+0\n  0.0E+0  0.0E+0  1.0E+0\n  0.0E+0  0.0E+0  0.0E+0\n"
+         << "         2         0         0\nRotated\n"
+         << "  0.0E+0  1.0E+0  0.0E+0\n -1.0E+0  0.0E+0  0.0E+0\n  0.0E+0  0.0E+0  1.0E+0\n  1.0E+1  0.0E+0  0.0E+0\n"
+         << "         3         1         0\nCylindrical\n"
+         << "  1.0E+0  0.0E+0  0.0E+0\n  0.0E+0  1.0E+0  0.0E+0\n  0.0E+0  0.0E+0  1.0E+0\n  0.0E+0  0.0E+0  0.0E+0\n"
+         << "    -1\n";
+    file << "    -1\n  2411\n"
+         << "         1         1         1        11\n  1.0E+3  2.0E+3  3.0E+3\n"
+         << "         2         2         2        11\n  1.0E+0  0.0E+0  0.0E+0\n"
+         << "         3         3         3        11\n  2.0E+3  9.0E+1  5.0E+0\n"
+         << "         4         7         7        11\n  5.0E+0  5.0E+0  5.0E+0\n"
+         << "    -1\n";
+}
+
+void expect_near(const std::array<double, 3>& value, const std::array<double, 3>& expected) {
+    for (std::size_t k = 0; k < 3; ++k) {
+        EXPECT_NEAR(value[k], expected[k], 1e-12);
+    }
+}
+
+} // namespace
+
+TEST(ReaderTransformTest, SiUnitsAndCoordinateSystems) {
+    auto path = std::filesystem::temp_directory_path() / "unvpp_frames.unv";
+    write_frames_file(path);
+
+    unvpp::ReadOptions options;
+    options.si_units = true;
+    options.coordinate_systems = true;
+    auto mesh = unvpp::read(path, options);
+
+    ASSERT_EQ(mesh.vertices().size(), 4);
+    expect_near(mesh.vertices()[0], {1., 2., 3.});
+    expect_near(mesh.vertices()[1], {0.010, 0.001, 0.});
+    expect_near(mesh.vertices()[2], {0., 2., 0.005});
+    expect_near(mesh.vertices()[3], {0.005, 0.005, 0.005});
+
+    // coordinates are in meters from now on
+    EXPECT_EQ(mesh.unit_system()->code(), 1);
+    EXPECT_EQ(mesh.unit_system()->length_scale(), 1.);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ReaderTransformTest, SeparateOptions) {
+    auto path = std::filesystem::temp_directory_path() / "unvpp_frames_separate.unv";
+    write_frames_file(path);
+
+    auto raw = unvpp::read(path);
+    expect_near(raw.vertices()[1], {1., 0., 0.});
+    EXPECT_EQ(raw.unit_system()->length_scale(), 1000.);
+
+    unvpp::ReadOptions si;
+    si.si_units = true;
+    expect_near(unvpp::read(path, si).vertices()[1], {0.001, 0., 0.});
+
+    // coordinate systems stay available to dataset handlers
+    unvpp::DatasetRegistry registry;
+    std::size_t n_lines{0};
+    registry.add(2420, [&](std::size_t, const std::vector<std::string_view>& lines) { n_lines = lines.size(); });
+
+    unvpp::ReadOptions frames;
+    frames.coordinate_systems = true;
+    frames.datasets = &registry;
+    auto mesh = unvpp::read(path, frames);
+    expect_near(mesh.vertices()[1], {10., 1., 0.});
+    expect_near(mesh.vertices()[2], {0., 2000., 5.});
+    EXPECT_EQ(n_lines, 20);
+
+    std::filesystem::remove(path);
+}
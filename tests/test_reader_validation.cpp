@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <unvpp/unvpp.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+const auto meshes_path = std::filesystem::path("../../tests/meshes");
+const unvpp::ReadOptions strict{nullptr, nullptr, unvpp::Validation::Strict};
+
+// copy of a mesh file, with one line replaced
+auto edit_line(const std::string& name, std::size_t line_number, const std::string& text)
+    -> std::filesystem::path {
+    auto path = std::filesystem::temp_directory_path() / ("unvpp_invalid_" + name);
+    std::ifstream input(meshes_path / name);
+    std::ofstream output(path);
+    std::string line;
+    for (std::size_t n = 1; std::getline(input, line); ++n) {
+        output << (n == line_number ? text : line) << '\n';
+    }
+    return path;
+}
+
+auto strict_error(const std::filesystem::path& path) -> std::string {
+    try {
+        unvpp::read(path, strict);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+} // namespace
+
+TEST(ReaderValidationTest, ValidMeshes) {
+    for (const auto* name : {"one_hex_cell.unv", "eight_hex_cube_with_groups.unv",
+                             "cylinderWithGroupsCoarse.unv", "one_hex_cell_results.unv"}) {
+        auto mesh = unvpp::read(meshes_path / name, strict);
+        auto lenient = unvpp::read(meshes_path / name);
+        EXPECT_EQ(mesh.vertices(), lenient.vertices());
+        EXPECT_EQ(mesh.elements()->size(), lenient.elements()->size());
+    }
+}
+
+TEST(ReaderValidationTest, UnknownVertex) {
+    auto path = edit_line("one_hex_cell.unv", 44, "         1        99");
+    EXPECT_NE(strict_error(path).find("Unknown vertex id 99 at line 44"), std::string::npos);
+
+    // lenient reads map the unknown vertex to the first one
+    auto mesh = unvpp::read(path);
+    EXPECT_EQ(mesh.elements()->at(1).vertices_ids()[1], 0);
+    std::filesystem::remove(path);
+}
+
+TEST(ReaderValidationTest, DuplicateVertex) {
+    auto path = edit_line("one_hex_cell.unv", 22, "         1         1         1        11");
+    EXPECT_NE(strict_error(path).find("Duplicate vertex id 1 at line 22"), std::string::npos);
+    EXPECT_NO_THROW(unvpp::read(path));
+    std::filesystem::remove(path);
+}
+
+TEST(ReaderValidationTest, DuplicateElement) {
+    auto path = edit_line("one_hex_cell.unv", 42, "         1        11         2         1         7         2");
+    EXPECT_NE(strict_error(path).find("Duplicate element id 1 at line 42"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(ReaderValidationTest, UnknownGroupElement) {
+    auto path = edit_line("eight_hex_cube_with_groups.unv", 219,
+                          "         8        27         0         0         8       999         0         0");
+    EXPECT_NE(strict_error(path).find("Unknown element id 999 in group walls at line 219"), std::string::npos);
+    std::filesystem::remove(path);
+}
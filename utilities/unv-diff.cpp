@@ -0,0 +1,238 @@
+/*
+MIT License
+
+Copyright (c) 2022 Mohamed Emara <mae.emara@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <unvpp/unvpp.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename T>
+auto values_or_empty(const std::optional<std::vector<T>> &values)
+    -> const std::vector<T> & {
+  // refers to the mesh values, rather than copying them
+  static const std::vector<T> empty;
+  return values.has_value() ? values.value() : empty;
+}
+
+void print_vertex(const std::array<double, 3> &vertex) {
+  // print all the digits written by unvpp::write(), so that vertices differing
+  // by less than the default precision do not look equal
+  std::ostringstream coordinates;
+  coordinates << std::setprecision(std::numeric_limits<double>::max_digits10)
+              << '(' << vertex[0] << ", " << vertex[1] << ", " << vertex[2]
+              << ')';
+  std::cout << coordinates.str();
+}
+
+void print_ids(const std::vector<std::size_t> &ids) {
+  for (auto id : ids) {
+    std::cout << ' ' << id;
+  }
+}
+
+auto first_vertex_difference(const unvpp::Mesh &lhs, const unvpp::Mesh &rhs,
+                             double tolerance) -> std::size_t {
+  const auto &a = lhs.vertices();
+  const auto &b = rhs.vertices();
+
+  auto close = [tolerance](const auto &u, const auto &v) {
+    for (std::size_t k = 0; k < 3; ++k) {
+      if (!(std::abs(u[k] - v[k]) <= tolerance)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto n = std::min(a.size(), b.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!close(a[i], b[i])) {
+      return i;
+    }
+  }
+  return n;
+}
+
+void diff_vertices(const unvpp::Mesh &lhs, const unvpp::Mesh &rhs,
+                   std::size_t first) {
+  const auto &a = lhs.vertices();
+  const auto &b = rhs.vertices();
+  if (a.size() != b.size()) {
+    std::cout << "   vertices count: " << a.size() << " vs " << b.size()
+              << std::endl;
+  }
+
+  if (first < std::min(a.size(), b.size())) {
+    std::cout << "   first difference at vertex " << first << ": ";
+    print_vertex(a[first]);
+    std::cout << " vs ";
+    print_vertex(b[first]);
+    std::cout << std::endl;
+  }
+}
+
+void diff_elements(const unvpp::Mesh &lhs, const unvpp::Mesh &rhs) {
+  const auto &a = values_or_empty(lhs.elements());
+  const auto &b = values_or_empty(rhs.elements());
+  if (a.size() != b.size()) {
+    std::cout << "   elements count: " << a.size() << " vs " << b.size()
+              << std::endl;
+  }
+
+  for (std::size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+    if (a[i].type() != b[i].type() ||
+        a[i].vertices_ids() != b[i].vertices_ids()) {
+      std::cout << "   first difference at element " << i << ":";
+      print_ids(a[i].vertices_ids());
+      std::cout << " vs";
+      print_ids(b[i].vertices_ids());
+      std::cout << std::endl;
+      return;
+    }
+  }
+}
+
+void diff_groups(const unvpp::Mesh &lhs, const unvpp::Mesh &rhs) {
+  const auto &a = values_or_empty(lhs.groups());
+  const auto &b = values_or_empty(rhs.groups());
+  if (a.size() != b.size()) {
+    std::cout << "   groups count: " << a.size() << " vs " << b.size()
+              << std::endl;
+  }
+
+  for (std::size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+    if (a[i].name() != b[i].name() || a[i].type() != b[i].type() ||
+        a[i].elements_ids() != b[i].elements_ids()) {
+      std::cout << "   first difference at group " << i << ": " << a[i].name()
+                << " (" << a[i].elements_ids().size() << " members) vs "
+                << b[i].name() << " (" << b[i].elements_ids().size()
+                << " members)" << std::endl;
+      return;
+    }
+  }
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  // convert argv to vector of strings
+  std::vector<std::string> args(argv, argv + argc);
+
+  // --tolerance t compares coordinates up to t
+  double tolerance = 0.;
+  auto tolerance_flag = std::find(args.begin() + 1, args.end(), "--tolerance");
+  if (tolerance_flag != args.end()) {
+    if (std::next(tolerance_flag) == args.end()) {
+      std::cerr << "Missing --tolerance value" << std::endl;
+      return 2;
+    }
+    const auto &value = *std::next(tolerance_flag);
+    try {
+      std::size_t end = 0;
+      tolerance = std::stod(value, &end);
+      if (end != value.size()) {
+        throw std::invalid_argument(value);
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Invalid --tolerance value " << value << std::endl;
+      return 2;
+    }
+    args.erase(tolerance_flag, std::next(tolerance_flag, 2));
+  }
+
+  if (args.size() != 3) {
+    std::cerr << "Usage: " << args[0] << " [--tolerance t] [lhs] [rhs]"
+              << std::endl;
+    return 2;
+  }
+
+  // both files are read concurrently
+  auto results = unvpp::read_many({args[1], args[2]});
+  for (const auto &result : results) {
+    if (!result.mesh.has_value()) {
+      std::cerr << result.path.string() << ": " << result.error << std::endl;
+      return 2;
+    }
+  }
+  const auto &lhs = results[0].mesh.value();
+  const auto &rhs = results[1].mesh.value();
+
+  auto a = lhs.fingerprint(tolerance);
+  auto b = rhs.fingerprint(tolerance);
+
+  // sections whose hashes match are the same, the others are compared
+  // record by record up to their first difference
+  bool same = true;
+  auto report = [&](const std::string &name, bool section_same) {
+    std::cout << name << ": " << (section_same ? "same" : "different")
+              << std::endl;
+    same = same && section_same;
+  };
+
+  auto units_same = a.units == b.units;
+  report("Units", units_same);
+  if (!units_same) {
+    std::cout << "   "
+              << lhs.unit_system().value_or(unvpp::UnitsSystem()).to_string()
+              << " vs "
+              << rhs.unit_system().value_or(unvpp::UnitsSystem()).to_string()
+              << std::endl;
+  }
+
+  // quantized coordinates within tolerance may still hash apart, so
+  // vertices are compared before being reported as different
+  auto first_vertex = a.vertices == b.vertices
+                          ? lhs.vertices().size()
+                          : first_vertex_difference(lhs, rhs, tolerance);
+  auto vertices_same = lhs.vertices().size() == rhs.vertices().size() &&
+                       first_vertex == lhs.vertices().size();
+  report("Vertices", vertices_same);
+  if (!vertices_same) {
+    diff_vertices(lhs, rhs, first_vertex);
+  }
+
+  auto connectivity_same = a.connectivity == b.connectivity;
+  report("Connectivity", connectivity_same);
+  if (!connectivity_same) {
+    diff_elements(lhs, rhs);
+  }
+
+  auto groups_same = a.groups == b.groups;
+  report("Groups", groups_same);
+  if (!groups_same) {
+    diff_groups(lhs, rhs);
+  }
+
+  return same ? 0 : 1;
+}
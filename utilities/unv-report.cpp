@@ -21,20 +21,99 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
+#include <unvpp/quality.h>
 #include <unvpp/unvpp.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <sstream>
+
+void print_quality(const unvpp::QualityReport &report,
+                   std::map<unvpp::ElementType, std::string> &type_names) {
+  const std::array<std::string, unvpp::quality_metrics_count> metric_names = {
+      "Aspect ratio", "Skewness", "Non-orthogonality", "Min Jacobian"};
+
+  std::cout << "Mesh quality:" << std::endl;
+  for (std::size_t type = 0; type < report.histograms.size(); ++type) {
+    auto element_type = static_cast<unvpp::ElementType>(type);
+    const auto &histograms = report.histograms[type];
+    if (histograms[0].count == 0) {
+      continue;
+    }
+
+    std::cout << "- " << type_names[element_type] << ":" << std::endl;
+    if (unvpp::corners_count(element_type) > 4 ||
+        element_type == unvpp::ElementType::Tetra) {
+      std::cout << "   negative volumes = " << report.negative_volumes[type]
+                << std::endl;
+    }
+
+    for (std::size_t metric = 0; metric < histograms.size(); ++metric) {
+      const auto &histogram = histograms[metric];
+      if (histogram.count == 0) {
+        continue;
+      }
+
+      std::cout << "   " << metric_names[metric] << ": min = " << histogram.min
+                << ", max = " << histogram.max << ", mean = "
+                << histogram.sum / static_cast<double>(histogram.count)
+                << std::endl;
+      for (std::size_t bin = 0; bin < histogram.counts.size(); ++bin) {
+        std::cout << "     [" << std::setw(5) << histogram.bounds[bin] << ", "
+                  << std::setw(5) << histogram.bounds[bin + 1]
+                  << ") " << histogram.counts[bin] << std::endl;
+      }
+    }
+  }
+
+  std::cout << "Worst elements:" << std::endl;
+  for (std::size_t metric = 0; metric < report.worst.size(); ++metric) {
+    std::cout << "- " << metric_names[metric] << ":";
+    for (const auto &offender : report.worst[metric]) {
+      std::cout << ' ' << offender.element << " (" << offender.value << ')';
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void print_memory_usage(const unvpp::MemoryUsage &usage) {
+  auto print = [](const std::string &name, std::size_t bytes) {
+    // format in a local stream so that std::cout keeps its precision
+    std::ostringstream mebibytes;
+    mebibytes << std::fixed << std::setprecision(2)
+              << static_cast<double>(bytes) / (1024. * 1024.);
+    std::cout << "- " << name << ": " << mebibytes.str() << " MiB (" << bytes
+              << " bytes)" << std::endl;
+  };
+
+  std::cout << "\nMemory usage:" << std::endl;
+  print("Vertices", usage.vertices);
+  print("Connectivity", usage.connectivity);
+  print("Groups", usage.groups);
+  print("Overhead", usage.overhead);
+  print("Total", usage.total());
+  std::cout << std::endl;
+}
 
 auto main(int argc, char *argv[]) -> int {
   // convert argv to vector of strings
   std::vector<std::string> args(argv, argv + argc);
 
+  // --quality also reports elements quality statistics
+  auto quality_flag = std::find(args.begin() + 1, args.end(), "--quality");
+  auto quality = quality_flag != args.end();
+  if (quality) {
+    args.erase(quality_flag);
+  }
+
   if (args.size() < 2) {
     std::cerr << "Too few args!" << std::endl;
-    std::cerr << "Usage: " << args[0] << " [input]" << std::endl;
+    std::cerr << "Usage: " << args[0] << " [--quality] [input]" << std::endl;
     return -1;
   }
 
@@ -93,6 +172,12 @@ auto main(int argc, char *argv[]) -> int {
     }
   }
 
+  print_memory_usage(mesh.memory_usage());
+
+  if (quality) {
+    print_quality(unvpp::analyze_quality(mesh), element_type_to_string);
+  }
+
   std::cout << std::setprecision(20)
             << "Time of execution: " << duration.count() << " milliseconds"
             << std::endl;